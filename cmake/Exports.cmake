@@ -82,6 +82,13 @@ install(FILES
    DESTINATION "."
 )
 
+# helper to pass precompiled header into flextool
+# see flextool_build_pch
+install(FILES
+   ${CMAKE_CURRENT_SOURCE_DIR}/cmake/FlextoolPch.cmake
+   DESTINATION "."
+)
+
 install(FILES
   "${CMAKE_CURRENT_SOURCE_DIR}/conf/flex_meta_plugin.conf" # source directory
   DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" # target directory
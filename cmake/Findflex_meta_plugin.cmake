@@ -55,3 +55,6 @@ if(EXISTS "${CMAKE_CURRENT_LIST_DIR}/cmake/flex_meta_plugin-config.cmake")
 endif()
 
 message(STATUS "flex_meta_plugin_HEADER_DIR=${flex_meta_plugin_HEADER_DIR}")
+
+# provides flextool_build_pch
+include(${CMAKE_CURRENT_LIST_DIR}/FlextoolPch.cmake OPTIONAL)
@@ -0,0 +1,68 @@
+﻿include_guard( DIRECTORY )
+
+# Adds build step that creates precompiled header from HEADER,
+# so heavy includes shared by all flextool input files
+# (base/, clang/, folly/, etc.) are parsed once instead of once per input file.
+# PCH is built at build time by custom target TARGET (part of ALL)
+# and rebuilt when HEADER or any header included by it changes
+# (compiler writes depfile, see -MD).
+# Sets OUT_ARGS to flextool arguments that load created PCH.
+# Code that runs flextool must depend on TARGET.
+#
+# NOTE: PCH must be created by clang with the same version
+# as clang libtooling used by flextool (i.e. clang from cling_conan)
+# and with the same language flags as passed to flextool.
+#
+# USAGE:
+# include(FlextoolPch)
+# flextool_build_pch(
+#   HEADER ${CMAKE_CURRENT_SOURCE_DIR}/flextool_prefix.hpp
+#   OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/flextool_prefix.hpp.pch
+#   COMPILER ${CONAN_CLING_CONAN_ROOT}/bin/clang++
+#   FLAGS -std=c++17 -I${CMAKE_CURRENT_SOURCE_DIR}
+#   TARGET my_target_pch
+#   OUT_ARGS flextool_pch_args)
+# list(APPEND ARGUMENTS ${flextool_pch_args}) # see RunFlextool.cmake
+# add_dependencies(my_target my_target_pch)
+function(flextool_build_pch)
+  set(options "")
+  set(oneValueArgs HEADER OUTPUT COMPILER TARGET OUT_ARGS)
+  set(multiValueArgs FLAGS)
+  cmake_parse_arguments(ARG
+    "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  foreach(required_arg HEADER OUTPUT COMPILER TARGET OUT_ARGS)
+    if(NOT ARG_${required_arg})
+      message(FATAL_ERROR "flextool_build_pch: ${required_arg} not set")
+    endif()
+  endforeach()
+
+  set(depfile "${ARG_OUTPUT}.d")
+  # DEPFILE is supported by Makefile generators since CMake 3.20
+  if(CMAKE_GENERATOR MATCHES "Ninja"
+     OR NOT CMAKE_VERSION VERSION_LESS 3.20)
+    set(depends_args DEPFILE ${depfile})
+  else()
+    set(depends_args IMPLICIT_DEPENDS CXX ${ARG_HEADER})
+  endif()
+
+  add_custom_command(
+    OUTPUT ${ARG_OUTPUT}
+    COMMAND ${ARG_COMPILER}
+            -x c++-header
+            ${ARG_FLAGS}
+            -MD -MF ${depfile} -MT ${ARG_OUTPUT}
+            -o ${ARG_OUTPUT}
+            ${ARG_HEADER}
+    DEPENDS ${ARG_HEADER}
+    ${depends_args}
+    COMMENT "flextool_build_pch: ${ARG_HEADER} -> ${ARG_OUTPUT}"
+    VERBATIM)
+  add_custom_target(${ARG_TARGET} ALL
+    DEPENDS ${ARG_OUTPUT})
+
+  set(${ARG_OUT_ARGS}
+    "--extra-arg=-include-pch"
+    "--extra-arg=${ARG_OUTPUT}"
+    PARENT_SCOPE)
+endfunction()
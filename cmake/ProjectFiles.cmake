@@ -6,4 +6,11 @@ list(APPEND flex_meta_plugin_SOURCES
   ${flex_meta_plugin_src_DIR}/EventHandler.cc
   ${flex_meta_plugin_include_DIR}/Tooling.hpp
   ${flex_meta_plugin_src_DIR}/Tooling.cc
+  ${flex_meta_plugin_include_DIR}/RecordFilter.hpp
+  ${flex_meta_plugin_src_DIR}/RecordFilter.cc
+  ${flex_meta_plugin_include_DIR}/columnar.hpp
+  ${flex_meta_plugin_include_DIR}/field_profile.hpp
+  ${flex_meta_plugin_include_DIR}/object_pool.hpp
+  ${flex_meta_plugin_include_DIR}/dynamic_access.hpp
+  ${flex_meta_plugin_include_DIR}/registry.hpp
 )
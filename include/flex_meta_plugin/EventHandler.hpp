@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <flex_meta_plugin/Tooling.hpp>
+#include <flex_meta_plugin/RecordFilter.hpp>
 
 #include <flexlib/ToolPlugin.hpp>
 #if defined(CLING_IS_ON)
@@ -20,6 +21,14 @@ public:
 
   ~FlexMetaEventHandler();
 
+  // records from system headers
+  // will be skipped by source transform rules
+  void SetSkipSystemHeaders(bool skipSystemHeaders);
+
+  // records from files with path that contains any of |patterns|
+  // will be skipped by source transform rules
+  void SetSkipPathPatterns(std::vector<std::string> patterns);
+
   void StringCommand(
     const ::plugin::ToolPlugin::Events::StringCommand& event);
 
@@ -32,10 +41,16 @@ public:
     const ::plugin::ToolPlugin::Events::RegisterAnnotationMethods& event);
 
 private:
+  // must outlive |tooling_|
+  RecordFilter recordFilter_;
+
   std::unique_ptr<MetaTooling> tooling_;
 
 #if defined(CLING_IS_ON)
-  ::cling_utils::ClingInterpreter* clingInterpreter_;
+  // nullptr unless |RegisterClingInterpreter| was called,
+  // host may skip interpreter creation because
+  // plugin declares `requires_cling=false`
+  ::cling_utils::ClingInterpreter* clingInterpreter_ = nullptr;
 #endif // CLING_IS_ON
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include <clang/AST/DeclBase.h>
+#include <clang/Basic/SourceManager.h>
+
+#include <base/logging.h>
+#include <base/sequenced_task_runner.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace plugin {
+
+/// \note Opt-in skip of annotated records by location.
+/// Plugin can not pre-filter records before flextool matches them
+/// (annotation matcher belongs to flextool), so this check runs
+/// after rule was called for record and only saves work of rule.
+/// Nothing is skipped by default, plugin configuration may enable:
+/// - `skip_system_headers` - records from system headers
+///   (including directories passed with `-isystem`),
+/// - `skip_path_patterns` - records from files with path
+///   that contains any of patterns.
+/// Warning is logged once per skipped file.
+class RecordFilter {
+public:
+  RecordFilter();
+
+  ~RecordFilter();
+
+  void SetSkipSystemHeaders(bool skipSystemHeaders);
+
+  // path is skipped if it contains any of `patterns`,
+  // i.e. "/third_party/"
+  void SetSkipPathPatterns(std::vector<std::string> patterns);
+
+  bool ShouldProcess(
+    const clang::Decl* record
+    , const clang::SourceManager& sourceManager);
+
+private:
+  bool skipSystemHeaders_ = false;
+
+  std::vector<std::string> skipPathPatterns_;
+
+  // paths of skipped files that were already reported
+  std::set<std::string> reportedPaths_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(RecordFilter);
+};
+
+} // namespace plugin
@@ -1,13 +1,22 @@
 ﻿#pragma once
 
+#include <flex_meta_plugin/RecordFilter.hpp>
+
 #include <flexlib/clangUtils.hpp>
 #include <flexlib/ToolPlugin.hpp>
 #if defined(CLING_IS_ON)
 #include "flexlib/ClingInterpreterModule.hpp"
 #endif // CLING_IS_ON
 
+#include <llvm/ADT/STLExtras.h>
+
 #include <base/logging.h>
 #include <base/sequenced_task_runner.h>
+#include <base/time/time.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 
 namespace plugin {
 
@@ -17,6 +26,7 @@ class MetaTooling {
 public:
   MetaTooling(
     const ::plugin::ToolPlugin::Events::RegisterAnnotationMethods& event
+    , RecordFilter* recordFilter
 #if defined(CLING_IS_ON)
     , ::cling_utils::ClingInterpreter* clingInterpreter
 #endif // CLING_IS_ON
@@ -28,10 +38,84 @@ public:
     make_reflect(
       const clang_utils::SourceTransformOptions& sourceTransformOptions);
 
+  // emits batch appender that writes reflectable fields
+  // into columnar file, see <flex_meta_plugin/columnar.hpp>
+  clang_utils::SourceTransformResult
+    make_columnar(
+      const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
+  // emits create / destroy helpers that allocate records
+  // from per-type pool, see <flex_meta_plugin/object_pool.hpp>
+  clang_utils::SourceTransformResult
+    make_pool(
+      const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
+  // emits validate() and batch validate_batch() that check
+  // "range(min,max)" attributes of reflectable fields
+  clang_utils::SourceTransformResult
+    make_validate(
+      const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
+  // emits static table of reflectable fields for access by name,
+  // see <flex_meta_plugin/dynamic_access.hpp>
+  clang_utils::SourceTransformResult
+    make_dynamic(
+      const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
+  // emits entry of global registry that allows to find record
+  // by name or type id, see <flex_meta_plugin/registry.hpp>
+  clang_utils::SourceTransformResult
+    make_registry(
+      const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
 private:
+  // record name -> field name -> access count
+  using FieldAccessProfile
+    = std::unordered_map<std::string
+        , std::unordered_map<std::string, uint64_t>>;
+
+  struct LoadedFieldProfile {
+    bool loaded = false;
+    // modification time of file when |profile| was parsed
+    base::Time lastModified;
+    FieldAccessProfile profile;
+  };
+
+  // loads profile dumped by <flex_meta_plugin/field_profile.hpp>,
+  // file is parsed again only if its modification time changed
+  const FieldAccessProfile& loadFieldProfile(const std::string& path);
+
+  // returns record bound by annotation matcher
+  // or nullptr if record must be skipped, see |RecordFilter|
+  const clang::CXXRecordDecl* getRecordToTransform(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions);
+
+  // appends public members generated for |record| to |output|,
+  // |indent| is indentation of members;
+  // returns false if nothing must be added to |record|
+  using AppendMembersCallback
+    = llvm::function_ref<bool(const clang::CXXRecordDecl* record
+        , const std::string& recordName
+        , const std::string& indent
+        , std::string& output)>;
+
+  // shared part of rules that add members to annotated record:
+  // rejects skipped and anonymous records and inserts
+  // members from |appendMembers| after `public:` at the end of record
+  clang_utils::SourceTransformResult transformRecord(
+    const char* ruleName
+    , const clang_utils::SourceTransformOptions& sourceTransformOptions
+    , AppendMembersCallback appendMembers);
+
   ::clang_utils::SourceTransformRules* sourceTransformRules_;
 
+  RecordFilter* recordFilter_;
+
+  // profile path -> loaded profile
+  std::unordered_map<std::string, LoadedFieldProfile> fieldProfiles_;
+
 #if defined(CLING_IS_ON)
+  // may be nullptr if host did not create interpreter
   ::cling_utils::ClingInterpreter* clingInterpreter_;
 #endif // CLING_IS_ON
 
@@ -0,0 +1,798 @@
+#pragma once
+
+/// \note Runtime support for code generated by `make_columnar`.
+/// Header-only and depends only on the standard library
+/// (plus POSIX mmap when available), so generated code
+/// can be used without linking to the plugin.
+///
+/// File format (all integers are native-endian,
+/// every section starts at 8-byte aligned file offset,
+/// so mapped columns can be used in-place):
+///
+///   header:
+///     char[8]  magic "FMCOLS01"
+///     uint32   format version (kFormatVersion)
+///     uint32   column count
+///   column descriptor (repeated `column count` times):
+///     uint8    ColumnType
+///     uint8[3] reserved (zero)
+///     uint32   name length
+///     char[]   name (not null-terminated), padded to 8 bytes
+///   row group (repeated until footer):
+///     char[8]  magic "FMROWGRP"
+///     uint64   row count
+///     uint64   byte size of column chunks that follow
+///     column chunk (repeated `column count` times):
+///       uint64 byte size of chunk payload (without padding)
+///       payload, padded to 8 bytes:
+///         numeric:     T[row count]
+///         string:      uint64 offsets[row count + 1], char data[]
+///         dict string: uint32 indices[row count],
+///                      padding to 8 bytes,
+///                      uint64 dictionary size,
+///                      uint64 offsets[dictionary size + 1],
+///                      char data[]
+///   footer:
+///     char[8]  magic "FMCOLEND"
+///     uint64   row group count
+///     uint64   total row count
+///
+/// Dictionaries are local to row group, so each row group
+/// can be written (and later read) independently.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FLEX_META_COLUMNAR_HAS_MMAP 1
+#endif
+
+namespace flex_meta {
+namespace columnar {
+
+static constexpr char kFileMagic[8]
+  = {'F', 'M', 'C', 'O', 'L', 'S', '0', '1'};
+static constexpr char kRowGroupMagic[8]
+  = {'F', 'M', 'R', 'O', 'W', 'G', 'R', 'P'};
+static constexpr char kFooterMagic[8]
+  = {'F', 'M', 'C', 'O', 'L', 'E', 'N', 'D'};
+
+static constexpr uint32_t kFormatVersion = 1;
+
+// rows are buffered in memory until row group is full,
+// then row group is streamed to disk
+static constexpr size_t kDefaultRowGroupSize = 64 * 1024;
+
+enum class ColumnType : uint8_t {
+  kBool = 1,
+  kInt8,
+  kUInt8,
+  kInt16,
+  kUInt16,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat,
+  kDouble,
+  kString,
+  kDictString,
+};
+
+template<typename T>
+constexpr ColumnType numericColumnType()
+{
+  static_assert(std::is_arithmetic<T>::value,
+    "numeric column must store arithmetic type");
+  if constexpr (std::is_same<T, bool>::value) {
+    return ColumnType::kBool;
+  } else if constexpr (std::is_same<T, float>::value) {
+    return ColumnType::kFloat;
+  } else if constexpr (std::is_same<T, double>::value) {
+    return ColumnType::kDouble;
+  } else if constexpr (std::is_floating_point<T>::value) {
+    static_assert(!std::is_floating_point<T>::value,
+      "long double columns are not supported");
+  } else if constexpr (sizeof(T) == 1) {
+    return std::is_signed<T>::value
+      ? ColumnType::kInt8 : ColumnType::kUInt8;
+  } else if constexpr (sizeof(T) == 2) {
+    return std::is_signed<T>::value
+      ? ColumnType::kInt16 : ColumnType::kUInt16;
+  } else if constexpr (sizeof(T) == 4) {
+    return std::is_signed<T>::value
+      ? ColumnType::kInt32 : ColumnType::kUInt32;
+  } else {
+    static_assert(sizeof(T) == 8, "unsupported integer size");
+    return std::is_signed<T>::value
+      ? ColumnType::kInt64 : ColumnType::kUInt64;
+  }
+}
+
+// type stored in numeric column for field of type `T`,
+// enums are stored as their underlying integer type
+template<typename T, typename = void>
+struct column_value {
+  using type = std::remove_cv_t<T>;
+};
+
+template<typename T>
+struct column_value<T, std::enable_if_t<std::is_enum<T>::value>> {
+  using type = std::underlying_type_t<std::remove_cv_t<T>>;
+};
+
+template<typename T>
+using column_value_t = typename column_value<T>::type;
+
+// returns 0 for string columns
+inline size_t columnElementSize(ColumnType type)
+{
+  switch (type) {
+  case ColumnType::kBool:
+  case ColumnType::kInt8:
+  case ColumnType::kUInt8:
+    return 1;
+  case ColumnType::kInt16:
+  case ColumnType::kUInt16:
+    return 2;
+  case ColumnType::kInt32:
+  case ColumnType::kUInt32:
+  case ColumnType::kFloat:
+    return 4;
+  case ColumnType::kInt64:
+  case ColumnType::kUInt64:
+  case ColumnType::kDouble:
+    return 8;
+  case ColumnType::kString:
+  case ColumnType::kDictString:
+    break;
+  }
+  return 0;
+}
+
+inline constexpr size_t alignTo8(size_t size)
+{
+  return (size + 7u) & ~static_cast<size_t>(7u);
+}
+
+/// \note Not thread-safe. Use one writer per export thread
+/// (and per output file).
+class BatchWriter {
+public:
+  explicit BatchWriter(
+    size_t rowGroupSize = kDefaultRowGroupSize)
+    : rowGroupSize_(rowGroupSize == 0 ? 1 : rowGroupSize)
+  {}
+
+  ~BatchWriter()
+  {
+    close();
+  }
+
+  BatchWriter(const BatchWriter&) = delete;
+  BatchWriter& operator=(const BatchWriter&) = delete;
+
+  // columns must be declared before `open`
+  template<typename T>
+  size_t addNumericColumn(std::string name)
+  {
+    return addColumn(std::move(name), numericColumnType<T>());
+  }
+
+  size_t addStringColumn(std::string name, bool dictionary)
+  {
+    return addColumn(std::move(name)
+      , dictionary ? ColumnType::kDictString : ColumnType::kString);
+  }
+
+  size_t columnCount() const
+  {
+    return columns_.size();
+  }
+
+  // writes file header and column descriptors
+  bool open(const std::string& path)
+  {
+    if (file_) {
+      return false;
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+      return false;
+    }
+    ok_ = true;
+    writeBytes(kFileMagic, sizeof(kFileMagic));
+    writePod(kFormatVersion);
+    writePod(static_cast<uint32_t>(columns_.size()));
+    for (const Column& column : columns_) {
+      writePod(static_cast<uint8_t>(column.type));
+      const uint8_t reserved[3] = {0, 0, 0};
+      writeBytes(reserved, sizeof(reserved));
+      writePod(static_cast<uint32_t>(column.name.size()));
+      writeBytes(column.name.data(), column.name.size());
+      writePadding(column.name.size());
+    }
+    return ok_;
+  }
+
+  // returns pointer to `count` contiguous slots that
+  // caller must fill; valid until next call on writer
+  template<typename T>
+  T* appendNumeric(size_t column, size_t count)
+  {
+    Column& target = columns_[column];
+    const size_t offset = target.data.size();
+    target.data.resize(offset + count * sizeof(T));
+    return reinterpret_cast<T*>(target.data.data() + offset);
+  }
+
+  void reserveStrings(size_t column, size_t count)
+  {
+    Column& target = columns_[column];
+    if (target.type == ColumnType::kDictString) {
+      target.indices.reserve(target.indices.size() + count);
+    } else {
+      target.offsets.reserve(target.offsets.size() + count);
+    }
+  }
+
+  void appendString(size_t column, std::string_view value)
+  {
+    Column& target = columns_[column];
+    if (target.type == ColumnType::kDictString) {
+      auto it = target.dictionary.find(value);
+      if (it == target.dictionary.end()) {
+        const uint32_t index
+          = static_cast<uint32_t>(target.dictionaryValues.size());
+        target.dictionaryValues.emplace_back(value);
+        // key must point to storage owned by writer
+        it = target.dictionary.emplace(
+          std::string_view(target.dictionaryValues.back()), index).first;
+      }
+      target.indices.push_back(it->second);
+    } else {
+      target.data.insert(target.data.end(), value.begin(), value.end());
+      target.offsets.push_back(target.data.size());
+    }
+  }
+
+  // must be called once per batch after all columns
+  // received `count` values
+  bool commitRows(size_t count)
+  {
+    bufferedRows_ += count;
+    if (bufferedRows_ >= rowGroupSize_) {
+      return flush();
+    }
+    return ok_;
+  }
+
+  // streams buffered rows to disk as one row group
+  bool flush()
+  {
+    if (!file_ || bufferedRows_ == 0) {
+      return ok_;
+    }
+    uint64_t groupSize = 0;
+    for (const Column& column : columns_) {
+      groupSize += sizeof(uint64_t) + alignTo8(chunkSize(column));
+    }
+    writeBytes(kRowGroupMagic, sizeof(kRowGroupMagic));
+    writePod(static_cast<uint64_t>(bufferedRows_));
+    writePod(groupSize);
+    for (Column& column : columns_) {
+      writeChunk(column);
+      column.clear();
+    }
+    totalRows_ += bufferedRows_;
+    bufferedRows_ = 0;
+    ++rowGroupCount_;
+    return ok_;
+  }
+
+  // flushes pending rows and writes footer
+  bool close()
+  {
+    if (!file_) {
+      return ok_;
+    }
+    flush();
+    writeBytes(kFooterMagic, sizeof(kFooterMagic));
+    writePod(static_cast<uint64_t>(rowGroupCount_));
+    writePod(static_cast<uint64_t>(totalRows_));
+    if (std::fclose(file_) != 0) {
+      ok_ = false;
+    }
+    file_ = nullptr;
+    return ok_;
+  }
+
+  uint64_t totalRows() const
+  {
+    return totalRows_ + bufferedRows_;
+  }
+
+  // number of rows that completes current row group,
+  // batches larger than that should be appended in parts
+  // to keep at most one row group in memory
+  size_t rowsUntilFlush() const
+  {
+    return bufferedRows_ < rowGroupSize_
+      ? rowGroupSize_ - bufferedRows_
+      : 1;
+  }
+
+private:
+  struct Column {
+    std::string name;
+    ColumnType type;
+    // numeric values or string bytes
+    std::vector<char> data;
+    // end offsets of strings in `data`
+    std::vector<uint64_t> offsets;
+    // per-row dictionary indices
+    std::vector<uint32_t> indices;
+    // deque keeps addresses of values stable,
+    // so `dictionary` keys may point to them
+    std::deque<std::string> dictionaryValues;
+    std::unordered_map<std::string_view, uint32_t> dictionary;
+
+    void clear()
+    {
+      data.clear();
+      offsets.clear();
+      indices.clear();
+      dictionary.clear();
+      dictionaryValues.clear();
+    }
+  };
+
+  size_t addColumn(std::string name, ColumnType type)
+  {
+    Column column;
+    column.name = std::move(name);
+    column.type = type;
+    columns_.push_back(std::move(column));
+    return columns_.size() - 1;
+  }
+
+  static size_t chunkSize(const Column& column)
+  {
+    switch (column.type) {
+    case ColumnType::kString:
+      return sizeof(uint64_t) * (column.offsets.size() + 1)
+        + column.data.size();
+    case ColumnType::kDictString: {
+      size_t bytes = 0;
+      for (const std::string& value : column.dictionaryValues) {
+        bytes += value.size();
+      }
+      return alignTo8(sizeof(uint32_t) * column.indices.size())
+        + sizeof(uint64_t)
+        + sizeof(uint64_t) * (column.dictionaryValues.size() + 1)
+        + bytes;
+    }
+    default:
+      return column.data.size();
+    }
+  }
+
+  void writeChunk(const Column& column)
+  {
+    const size_t payload = chunkSize(column);
+    writePod(static_cast<uint64_t>(payload));
+    if (column.type == ColumnType::kString) {
+      writePod(static_cast<uint64_t>(0));
+      writeBytes(column.offsets.data()
+        , sizeof(uint64_t) * column.offsets.size());
+      writeBytes(column.data.data(), column.data.size());
+    } else if (column.type == ColumnType::kDictString) {
+      writeBytes(column.indices.data()
+        , sizeof(uint32_t) * column.indices.size());
+      writePadding(sizeof(uint32_t) * column.indices.size());
+      writePod(static_cast<uint64_t>(column.dictionaryValues.size()));
+      uint64_t offset = 0;
+      writePod(offset);
+      for (const std::string& value : column.dictionaryValues) {
+        offset += value.size();
+        writePod(offset);
+      }
+      for (const std::string& value : column.dictionaryValues) {
+        writeBytes(value.data(), value.size());
+      }
+    } else {
+      writeBytes(column.data.data(), column.data.size());
+    }
+    writePadding(payload);
+  }
+
+  template<typename T>
+  void writePod(const T& value)
+  {
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeBytes(const void* data, size_t size)
+  {
+    if (size != 0
+        && std::fwrite(data, 1, size, file_) != size) {
+      ok_ = false;
+    }
+  }
+
+  void writePadding(size_t writtenSize)
+  {
+    static const char kZeros[8] = {};
+    writeBytes(kZeros, alignTo8(writtenSize) - writtenSize);
+  }
+
+  const size_t rowGroupSize_;
+
+  std::vector<Column> columns_;
+
+  std::FILE* file_ = nullptr;
+
+  bool ok_ = true;
+
+  size_t bufferedRows_ = 0;
+
+  uint64_t totalRows_ = 0;
+
+  uint64_t rowGroupCount_ = 0;
+};
+
+/// \note Maps whole file into memory (falls back to reading
+/// file into buffer if mmap is not available).
+/// Views returned by reader are valid while reader is alive.
+class MappedReader {
+public:
+  struct ColumnInfo {
+    std::string_view name;
+    ColumnType type;
+  };
+
+  class RowGroup {
+  public:
+    uint64_t rowCount() const
+    {
+      return rowCount_;
+    }
+
+    template<typename T>
+    const T* numeric(size_t column) const
+    {
+      return reinterpret_cast<const T*>(chunks_[column]);
+    }
+
+    std::string_view string(size_t column, uint64_t row) const
+    {
+      const char* chunk = chunks_[column];
+      if (types_[column] == ColumnType::kDictString) {
+        const uint32_t index
+          = reinterpret_cast<const uint32_t*>(chunk)[row];
+        const char* dict = chunk
+          + alignTo8(sizeof(uint32_t) * rowCount_);
+        const uint64_t dictSize
+          = *reinterpret_cast<const uint64_t*>(dict);
+        const uint64_t* offsets
+          = reinterpret_cast<const uint64_t*>(dict + sizeof(uint64_t));
+        const char* bytes
+          = reinterpret_cast<const char*>(offsets + dictSize + 1);
+        return std::string_view(bytes + offsets[index]
+          , offsets[index + 1] - offsets[index]);
+      }
+      const uint64_t* offsets
+        = reinterpret_cast<const uint64_t*>(chunk);
+      const char* bytes
+        = reinterpret_cast<const char*>(offsets + rowCount_ + 1);
+      return std::string_view(bytes + offsets[row]
+        , offsets[row + 1] - offsets[row]);
+    }
+
+  private:
+    friend class MappedReader;
+
+    uint64_t rowCount_ = 0;
+
+    std::vector<const char*> chunks_;
+
+    const ColumnType* types_ = nullptr;
+  };
+
+  MappedReader() = default;
+
+  ~MappedReader()
+  {
+    unmap();
+  }
+
+  MappedReader(const MappedReader&) = delete;
+  MappedReader& operator=(const MappedReader&) = delete;
+
+  bool open(const std::string& path)
+  {
+    unmap();
+    if (!map(path)) {
+      return false;
+    }
+    if (!parse()) {
+      unmap();
+      return false;
+    }
+    return true;
+  }
+
+  const std::vector<ColumnInfo>& columns() const
+  {
+    return columns_;
+  }
+
+  const std::vector<RowGroup>& rowGroups() const
+  {
+    return rowGroups_;
+  }
+
+  uint64_t totalRows() const
+  {
+    return totalRows_;
+  }
+
+private:
+  bool map(const std::string& path)
+  {
+#if defined(FLEX_META_COLUMNAR_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size)
+      , PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    data_ = static_cast<const char*>(addr);
+    size_ = static_cast<size_t>(st.st_size);
+    mapped_ = true;
+    return true;
+#else
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+      return false;
+    }
+    char chunk[4096];
+    std::vector<char> bytes;
+    size_t read = 0;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      bytes.insert(bytes.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+    // uint64_t storage keeps columns 8-byte aligned
+    buffer_.resize(alignTo8(bytes.size()) / sizeof(uint64_t));
+    std::memcpy(buffer_.data(), bytes.data(), bytes.size());
+    data_ = reinterpret_cast<const char*>(buffer_.data());
+    size_ = bytes.size();
+    return size_ != 0;
+#endif
+  }
+
+  void unmap()
+  {
+#if defined(FLEX_META_COLUMNAR_HAS_MMAP)
+    if (mapped_) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+#else
+    buffer_.clear();
+#endif
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    columns_.clear();
+    types_.clear();
+    rowGroups_.clear();
+    totalRows_ = 0;
+  }
+
+  template<typename T>
+  bool readPod(size_t& pos, T& value) const
+  {
+    if (sizeof(T) > size_ - pos) {
+      return false;
+    }
+    std::memcpy(&value, data_ + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  // returns false if |offsets| are not ascending from 0
+  // or point past |bytesSize|
+  static bool isValidOffsets(
+    const char* offsets, uint64_t count, uint64_t bytesSize)
+  {
+    uint64_t previous = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      uint64_t offset = 0;
+      std::memcpy(&offset, offsets + i * sizeof(uint64_t), sizeof(offset));
+      if ((i == 0 && offset != 0) || offset < previous
+          || offset > bytesSize) {
+        return false;
+      }
+      previous = offset;
+    }
+    return true;
+  }
+
+  // checks offsets, dictionary size and dictionary indices,
+  // so |RowGroup::string| can trust them
+  static bool isValidStringChunk(
+    ColumnType type, const char* chunk, uint64_t chunkSize
+    , uint64_t rowCount)
+  {
+    if (type == ColumnType::kString) {
+      // offsets[row count + 1]
+      if (rowCount >= chunkSize / sizeof(uint64_t)) {
+        return false;
+      }
+      const uint64_t offsetsSize = sizeof(uint64_t) * (rowCount + 1);
+      return isValidOffsets(chunk, rowCount + 1, chunkSize - offsetsSize);
+    }
+    if (rowCount > chunkSize / sizeof(uint32_t)) {
+      return false;
+    }
+    const uint64_t indicesSize = alignTo8(sizeof(uint32_t) * rowCount);
+    if (indicesSize > chunkSize
+        || chunkSize - indicesSize < sizeof(uint64_t)) {
+      return false;
+    }
+    const char* dict = chunk + indicesSize;
+    const uint64_t dictBytes = chunkSize - indicesSize - sizeof(uint64_t);
+    uint64_t dictSize = 0;
+    std::memcpy(&dictSize, dict, sizeof(dictSize));
+    // offsets[dictionary size + 1]
+    if (dictSize >= dictBytes / sizeof(uint64_t)) {
+      return false;
+    }
+    const uint64_t offsetsSize = sizeof(uint64_t) * (dictSize + 1);
+    if (!isValidOffsets(dict + sizeof(uint64_t), dictSize + 1
+          , dictBytes - offsetsSize)) {
+      return false;
+    }
+    for (uint64_t row = 0; row < rowCount; ++row) {
+      uint32_t index = 0;
+      std::memcpy(&index, chunk + row * sizeof(uint32_t), sizeof(index));
+      if (index >= dictSize) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // validates whole file, so accessors of |RowGroup|
+  // never read outside of mapped memory
+  bool parse()
+  {
+    size_t pos = 0;
+    uint32_t version = 0;
+    uint32_t columnCount = 0;
+    if (size_ < sizeof(kFileMagic)
+        || std::memcmp(data_, kFileMagic, sizeof(kFileMagic)) != 0) {
+      return false;
+    }
+    pos += sizeof(kFileMagic);
+    if (!readPod(pos, version) || version != kFormatVersion
+        || !readPod(pos, columnCount)) {
+      return false;
+    }
+    types_.reserve(columnCount);
+    for (uint32_t i = 0; i < columnCount; ++i) {
+      uint8_t type = 0;
+      uint8_t reserved[3];
+      uint32_t nameSize = 0;
+      if (!readPod(pos, type) || !readPod(pos, reserved)
+          || !readPod(pos, nameSize) || alignTo8(nameSize) > size_ - pos
+          || type < static_cast<uint8_t>(ColumnType::kBool)
+          || type > static_cast<uint8_t>(ColumnType::kDictString)) {
+        return false;
+      }
+      types_.push_back(static_cast<ColumnType>(type));
+      columns_.push_back(ColumnInfo{
+        std::string_view(data_ + pos, nameSize)
+        , static_cast<ColumnType>(type)});
+      pos += alignTo8(nameSize);
+    }
+    while (pos + sizeof(kRowGroupMagic) <= size_) {
+      if (std::memcmp(data_ + pos, kFooterMagic
+            , sizeof(kFooterMagic)) == 0) {
+        pos += sizeof(kFooterMagic);
+        uint64_t groupCount = 0;
+        uint64_t rowCount = 0;
+        for (const RowGroup& group : rowGroups_) {
+          rowCount += group.rowCount_;
+        }
+        return readPod(pos, groupCount)
+          && readPod(pos, totalRows_)
+          && groupCount == rowGroups_.size()
+          && totalRows_ == rowCount;
+      }
+      if (std::memcmp(data_ + pos, kRowGroupMagic
+            , sizeof(kRowGroupMagic)) != 0) {
+        return false;
+      }
+      pos += sizeof(kRowGroupMagic);
+      RowGroup group;
+      uint64_t groupSize = 0;
+      if (!readPod(pos, group.rowCount_) || !readPod(pos, groupSize)
+          || groupSize > size_ - pos) {
+        return false;
+      }
+      const size_t groupEnd = pos + groupSize;
+      group.types_ = types_.data();
+      group.chunks_.reserve(columnCount);
+      for (uint32_t i = 0; i < columnCount; ++i) {
+        uint64_t chunkSize = 0;
+        if (!readPod(pos, chunkSize) || pos > groupEnd
+            || chunkSize > groupEnd - pos
+            || alignTo8(chunkSize) > groupEnd - pos) {
+          return false;
+        }
+        const size_t elementSize = columnElementSize(types_[i]);
+        if (elementSize != 0
+            && (chunkSize % elementSize != 0
+                || chunkSize / elementSize != group.rowCount_)) {
+          return false;
+        }
+        if (elementSize == 0
+            && !isValidStringChunk(types_[i], data_ + pos
+                 , chunkSize, group.rowCount_)) {
+          return false;
+        }
+        group.chunks_.push_back(data_ + pos);
+        pos += alignTo8(chunkSize);
+      }
+      rowGroups_.push_back(std::move(group));
+    }
+    // missing footer
+    return false;
+  }
+
+  const char* data_ = nullptr;
+
+  size_t size_ = 0;
+
+  bool mapped_ = false;
+
+#if !defined(FLEX_META_COLUMNAR_HAS_MMAP)
+  std::vector<uint64_t> buffer_;
+#endif
+
+  std::vector<ColumnInfo> columns_;
+
+  std::vector<ColumnType> types_;
+
+  std::vector<RowGroup> rowGroups_;
+
+  uint64_t totalRows_ = 0;
+};
+
+} // namespace columnar
+} // namespace flex_meta
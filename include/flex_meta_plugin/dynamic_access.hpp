@@ -0,0 +1,185 @@
+#pragma once
+
+/// \note Runtime support for code generated by `make_dynamic`.
+/// Header-only and depends only on the standard library.
+///
+/// `make_dynamic` emits one static read-only table per record:
+///   static ::flex_meta::dynamic::FieldTable dynamic_fields();
+/// Table entries are sorted by field name and contain
+/// plain function pointers (no captures, no allocations),
+/// so access by name is binary search plus one indirect call:
+///   const int* age = ::flex_meta::dynamic::get<int>(person, "age");
+///   ::flex_meta::dynamic::set(person, "age", 42);
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace flex_meta {
+namespace dynamic {
+
+// type of field value, typed access is checked against it
+enum class FieldType : uint8_t {
+  // type without own tag, only untyped access (see |FieldEntry|)
+  kOther,
+  kBool,
+  kChar,
+  kInt8,
+  kUInt8,
+  kInt16,
+  kUInt16,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat,
+  kDouble,
+  kString,
+};
+
+template<typename T>
+constexpr FieldType fieldTypeOf()
+{
+  using Type = std::remove_cv_t<T>;
+  if constexpr (std::is_same<Type, bool>::value) {
+    return FieldType::kBool;
+  } else if constexpr (std::is_same<Type, char>::value) {
+    return FieldType::kChar;
+  } else if constexpr (std::is_same<Type, wchar_t>::value
+                       || std::is_same<Type, char16_t>::value
+                       || std::is_same<Type, char32_t>::value) {
+    return FieldType::kOther;
+  } else if constexpr (std::is_integral<Type>::value) {
+    // tag depends on size and signedness, not on spelling,
+    // so i.e. `long long` and `long` are both kInt64 on LP64
+    if constexpr (sizeof(Type) == 1) {
+      return std::is_signed<Type>::value
+        ? FieldType::kInt8 : FieldType::kUInt8;
+    } else if constexpr (sizeof(Type) == 2) {
+      return std::is_signed<Type>::value
+        ? FieldType::kInt16 : FieldType::kUInt16;
+    } else if constexpr (sizeof(Type) == 4) {
+      return std::is_signed<Type>::value
+        ? FieldType::kInt32 : FieldType::kUInt32;
+    } else if constexpr (sizeof(Type) == 8) {
+      return std::is_signed<Type>::value
+        ? FieldType::kInt64 : FieldType::kUInt64;
+    } else {
+      return FieldType::kOther;
+    }
+  } else if constexpr (std::is_same<Type, float>::value) {
+    return FieldType::kFloat;
+  } else if constexpr (std::is_same<Type, double>::value) {
+    return FieldType::kDouble;
+  } else if constexpr (std::is_same<Type, std::string>::value) {
+    return FieldType::kString;
+  } else {
+    return FieldType::kOther;
+  }
+}
+
+// returns pointer to field of |object|
+using FieldGetter = const void* (*)(const void* object);
+
+// copies |value| (points to field type) into field of |object|
+using FieldSetter = void (*)(void* object, const void* value);
+
+// offset of field that is not known at compile time
+// (record is not standard layout)
+static constexpr size_t kNoOffset = static_cast<size_t>(-1);
+
+struct FieldEntry {
+  const char* name;
+
+  // offsetof(Record, field) or |kNoOffset|
+  size_t offset;
+
+  FieldType type;
+
+  FieldGetter getter;
+
+  // nullptr if field is not copy-assignable (i.e. const)
+  FieldSetter setter;
+};
+
+// entries are sorted by name
+struct FieldTable {
+  const FieldEntry* entries;
+
+  size_t size;
+
+  const FieldEntry* begin() const { return entries; }
+
+  const FieldEntry* end() const { return entries + size; }
+};
+
+template<typename Record, typename Field, Field Record::*kMember>
+const void* readField(const void* object)
+{
+  return &(static_cast<const Record*>(object)->*kMember);
+}
+
+template<typename Record, typename Field, Field Record::*kMember>
+void writeField(void* object, const void* value)
+{
+  static_cast<Record*>(object)->*kMember
+    = *static_cast<const Field*>(value);
+}
+
+template<typename Record, typename Field, Field Record::*kMember>
+constexpr FieldSetter fieldSetter()
+{
+  if constexpr (std::is_copy_assignable<Field>::value) {
+    return &writeField<Record, Field, kMember>;
+  } else {
+    return nullptr;
+  }
+}
+
+// returns nullptr if table has no field with |name|
+inline const FieldEntry* findField(
+  const FieldTable& table, std::string_view name)
+{
+  const FieldEntry* it = std::lower_bound(table.begin(), table.end(), name
+    , [](const FieldEntry& entry, std::string_view name) {
+        return std::string_view(entry.name) < name;
+      });
+  if (it == table.end() || std::string_view(it->name) != name) {
+    return nullptr;
+  }
+  return it;
+}
+
+// returns nullptr if |Record| has no field with |name| of type |T|
+template<typename T, typename Record>
+const T* get(const Record& object, std::string_view name)
+{
+  static_assert(fieldTypeOf<T>() != FieldType::kOther
+    , "use findField() and FieldEntry::getter for this type");
+  const FieldEntry* entry = findField(Record::dynamic_fields(), name);
+  if (!entry || entry->type != fieldTypeOf<T>()) {
+    return nullptr;
+  }
+  return static_cast<const T*>(entry->getter(&object));
+}
+
+// returns false if |Record| has no assignable field
+// with |name| of type |T|
+template<typename T, typename Record>
+bool set(Record& object, std::string_view name, const T& value)
+{
+  static_assert(fieldTypeOf<T>() != FieldType::kOther
+    , "use findField() and FieldEntry::setter for this type");
+  const FieldEntry* entry = findField(Record::dynamic_fields(), name);
+  if (!entry || entry->type != fieldTypeOf<T>() || !entry->setter) {
+    return false;
+  }
+  entry->setter(&object, &value);
+  return true;
+}
+
+} // namespace dynamic
+} // namespace flex_meta
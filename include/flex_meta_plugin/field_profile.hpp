@@ -0,0 +1,276 @@
+#pragma once
+
+/// \note Runtime support for field access counters emitted
+/// by `make_reflect(profile_fields = "true")`.
+/// Header-only and depends only on the standard library.
+///
+/// Counters are compiled into generated accessors only if
+/// FLEX_META_PROFILE_FIELDS is defined, otherwise generated
+/// accessors are plain getters and this header is not required.
+///
+/// Each thread increments only its own shard of counters
+/// (no atomic read-modify-write, no locks on hot path),
+/// mutex is used only when thread touches record type first time,
+/// when thread exits and when profile is dumped.
+/// On thread exit counters of its shard are added
+/// to per-record totals and shard is freed, so memory does not grow
+/// with number of threads that ever touched record.
+///
+/// Profile format (text, read by plugin on next run
+/// via `make_reflect(profile_data = "path")`):
+///   # flex_meta field profile v1
+///   <record>\t<field>\t<access count>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace flex_meta {
+namespace profile {
+
+static constexpr const char kProfileHeader[]
+  = "# flex_meta field profile v1";
+
+// shards of different threads never share cache line
+struct alignas(64) CounterBlock {
+  static constexpr size_t kCounters
+    = 64 / sizeof(std::atomic<uint64_t>);
+
+  std::atomic<uint64_t> counters[kCounters];
+};
+
+inline std::atomic<uint64_t>& fieldCounter(
+  CounterBlock* blocks, size_t field)
+{
+  return blocks[field / CounterBlock::kCounters]
+    .counters[field % CounterBlock::kCounters];
+}
+
+struct FieldCount {
+  std::string record;
+
+  std::string field;
+
+  uint64_t count;
+};
+
+class Registry {
+public:
+  // never destroyed, so counters can be dumped
+  // from destructors of static objects
+  static Registry& instance()
+  {
+    static Registry* registry = new Registry;
+    return *registry;
+  }
+
+  // returns zero-initialized counters owned by registry,
+  // counters stay valid until |releaseShard|
+  CounterBlock* addShard(
+    const char* record
+    , const char* const* fields
+    , size_t fieldCount)
+  {
+    const size_t blockCount
+      = fieldCount / CounterBlock::kCounters + 1;
+    std::unique_ptr<CounterBlock[]> blocks(new CounterBlock[blockCount]);
+    for (size_t i = 0; i < blockCount; ++i) {
+      for (std::atomic<uint64_t>& counter : blocks[i].counters) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+    CounterBlock* counters = blocks.get();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record* target = findRecord(record);
+    if (!target) {
+      records_.push_back(Record{record, fields, fieldCount
+        , std::vector<uint64_t>(fieldCount, 0), {}});
+      target = &records_.back();
+    }
+    target->shards.push_back(std::move(blocks));
+    return counters;
+  }
+
+  // adds |counters| (returned by |addShard|) to totals of |record|
+  // and frees them, called when thread that owns shard exits
+  void releaseShard(const char* record, CounterBlock* counters)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record* target = findRecord(record);
+    if (!target) {
+      return;
+    }
+    auto it = std::find_if(target->shards.begin(), target->shards.end()
+      , [counters](const std::unique_ptr<CounterBlock[]>& shard) {
+          return shard.get() == counters;
+        });
+    if (it == target->shards.end()) {
+      return;
+    }
+    for (size_t field = 0; field < target->fieldCount; ++field) {
+      target->totals[field] += fieldCounter(counters, field)
+        .load(std::memory_order_relaxed);
+    }
+    target->shards.erase(it);
+  }
+
+  // number of shards of threads that did not exit yet
+  size_t shardCount(const char* record) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Record& it : records_) {
+      if (std::strcmp(it.name, record) == 0) {
+        return it.shards.size();
+      }
+    }
+    return 0;
+  }
+
+  // sums counters of exited and running threads
+  std::vector<FieldCount> collect() const
+  {
+    std::vector<FieldCount> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Record& record : records_) {
+      for (size_t field = 0; field < record.fieldCount; ++field) {
+        uint64_t count = record.totals[field];
+        for (const std::unique_ptr<CounterBlock[]>& shard : record.shards) {
+          count += fieldCounter(shard.get(), field)
+            .load(std::memory_order_relaxed);
+        }
+        result.push_back(FieldCount{
+          record.name, record.fields[field], count});
+      }
+    }
+    return result;
+  }
+
+  bool dump(const std::string& path) const
+  {
+    const std::vector<FieldCount> counts = collect();
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+      return false;
+    }
+    bool ok = std::fprintf(file, "%s\n", kProfileHeader) > 0;
+    for (const FieldCount& it : counts) {
+      ok = ok && std::fprintf(file, "%s\t%s\t%llu\n"
+        , it.record.c_str(), it.field.c_str()
+        , static_cast<unsigned long long>(it.count)) > 0;
+    }
+    return std::fclose(file) == 0 && ok;
+  }
+
+private:
+  struct Record {
+    const char* name;
+
+    const char* const* fields;
+
+    size_t fieldCount;
+
+    // counters of exited threads
+    std::vector<uint64_t> totals;
+
+    // counters of running threads
+    std::vector<std::unique_ptr<CounterBlock[]>> shards;
+  };
+
+  Registry() = default;
+
+  // expects |mutex_| to be locked
+  Record* findRecord(const char* record)
+  {
+    for (Record& it : records_) {
+      if (std::strcmp(it.name, record) == 0) {
+        return &it;
+      }
+    }
+    return nullptr;
+  }
+
+  mutable std::mutex mutex_;
+
+  std::vector<Record> records_;
+};
+
+// |Record| must provide (generated by `make_reflect`):
+//   static constexpr const char* flex_meta_profile_record;
+//   static constexpr const char* flex_meta_profile_fields[];
+template<typename Record>
+class FieldProfile {
+public:
+  static void hit(size_t field) noexcept
+  {
+    CounterBlock* counters = localCounters_;
+    if (!counters) {
+      counters = createLocalCounters();
+    }
+    // only calling thread writes to its shard
+    std::atomic<uint64_t>& counter = fieldCounter(counters, field);
+    counter.store(counter.load(std::memory_order_relaxed) + 1
+      , std::memory_order_relaxed);
+  }
+
+private:
+  // merges shard of exiting thread into totals of |Record|
+  struct ShardReleaser {
+    ~ShardReleaser()
+    {
+      if (localCounters_) {
+        Registry::instance().releaseShard(
+          Record::flex_meta_profile_record, localCounters_);
+        localCounters_ = nullptr;
+      }
+      released_ = true;
+    }
+  };
+
+  static CounterBlock* createLocalCounters()
+  {
+    localCounters_ = Registry::instance().addShard(
+      Record::flex_meta_profile_record
+      , Record::flex_meta_profile_fields
+      , std::size(Record::flex_meta_profile_fields));
+    if (!released_) {
+      // destroyed on thread exit, constructed once per thread
+      static thread_local ShardReleaser releaser;
+      (void)releaser;
+    }
+    // else hit from destructor of other thread-local object
+    // after releaser was destroyed, shard is kept until process exit
+    return localCounters_;
+  }
+
+  // plain pointers, so hot path does not check
+  // initialization of thread-local object
+  static thread_local CounterBlock* localCounters_;
+
+  static thread_local bool released_;
+};
+
+template<typename Record>
+thread_local CounterBlock* FieldProfile<Record>::localCounters_
+  = nullptr;
+
+template<typename Record>
+thread_local bool FieldProfile<Record>::released_ = false;
+
+// writes counters of all threads to |path|,
+// pass |path| to `make_reflect(profile_data = "path")` on next run
+inline bool dumpFieldProfile(const std::string& path)
+{
+  return Registry::instance().dump(path);
+}
+
+} // namespace profile
+} // namespace flex_meta
@@ -0,0 +1,303 @@
+#pragma once
+
+/// \note Runtime support for code generated by `make_pool`.
+/// Header-only and depends only on the standard library.
+///
+/// One pool per type (see `ObjectPool<T>::instance()`).
+/// Objects are stored in cache-line aligned slots carved from slabs,
+/// so objects used by different threads never share cache line.
+/// Each thread keeps its own free list (no synchronization on
+/// `create` / `destroy` fast path). Free slots move between threads
+/// in batches through shared stack of batches:
+/// - thread with empty free list pops one batch
+///   (or allocates new slab if stack is empty),
+/// - thread with too many free slots pushes one batch.
+/// Shared stack is guarded by mutex instead of being lock-free
+/// (lock-free pop would need double-width CAS to avoid ABA problem):
+/// push and pop are O(1) regardless of stack size and mutex is taken
+/// at most once per |kBatchSize| calls of `create` / `destroy`,
+/// so it is rarely contended.
+/// Slabs are never returned to system allocator.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace flex_meta {
+namespace pool {
+
+static constexpr size_t kCacheLineSize = 64;
+
+// resets value to value-initialized state
+template<typename T>
+void resetValue(T& value)
+{
+  if constexpr (std::is_array<T>::value) {
+    for (auto& element : value) {
+      resetValue(element);
+    }
+  } else {
+    value = T{};
+  }
+}
+
+template<typename T
+  , size_t kBatchSize = 64
+  , size_t kSlabSlots = 1024>
+class ObjectPool {
+public:
+  static_assert(kBatchSize > 0 && kSlabSlots >= kBatchSize
+    , "slab must contain at least one batch");
+
+  // never destroyed and per-thread free lists are trivially destructible
+  // (see |CacheReleaser|), so objects may be destroyed
+  // from destructors of static and thread-local objects
+  static ObjectPool& instance()
+  {
+    static ObjectPool* pool = new ObjectPool;
+    return *pool;
+  }
+
+  template<typename... Args>
+  T* create(Args&&... args)
+  {
+    FreeSlot* slot = popLocal();
+    try {
+      return ::new (static_cast<void*>(slot))
+        T(std::forward<Args>(args)...);
+    } catch (...) {
+      pushLocal(slot);
+      throw;
+    }
+  }
+
+  void destroy(T* object)
+  {
+    if (!object) {
+      return;
+    }
+    object->~T();
+    pushLocal(::new (static_cast<void*>(object)) FreeSlot{});
+  }
+
+  // number of slabs allocated by all threads
+  size_t slabCount() const
+  {
+    return slabCount_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // placed into unused slot
+  struct FreeSlot {
+    // next slot in the same free list or batch
+    FreeSlot* next = nullptr;
+
+    // next batch in shared stack, used only by first slot of batch
+    FreeSlot* nextBatch = nullptr;
+
+    // number of slots in batch, used only by first slot of batch
+    size_t batchSize = 0;
+  };
+
+  static constexpr size_t kSlotAlignment
+    = std::max(alignof(T), kCacheLineSize);
+
+  // multiple of cache line size
+  static constexpr size_t kSlotSize
+    = (std::max(sizeof(T), sizeof(FreeSlot)) + kSlotAlignment - 1)
+      / kSlotAlignment * kSlotAlignment;
+
+  struct alignas(kSlotAlignment) Slot {
+    unsigned char storage[kSlotSize];
+  };
+
+  struct Slab {
+    Slot slots[kSlabSlots];
+
+    Slab* next = nullptr;
+  };
+
+  enum class LocalState : unsigned char {
+    kUnregistered,
+    kRegistered,
+    // |CacheReleaser| of calling thread is destroyed
+    kReleased,
+  };
+
+  // returns free slots of exiting thread to shared stack,
+  // so they are reused by other threads
+  struct CacheReleaser {
+    ~CacheReleaser()
+    {
+      ObjectPool& pool = instance();
+      while (localSize_ != 0) {
+        pool.pushBatch(detachLocalBatch(std::min(localSize_, kBatchSize)));
+      }
+      localState_ = LocalState::kReleased;
+    }
+  };
+
+  // called when free list of calling thread becomes non-empty
+  static void registerReleaser()
+  {
+    if (localState_ == LocalState::kUnregistered) {
+      localState_ = LocalState::kRegistered;
+      // destroyed on thread exit, constructed once per thread
+      static thread_local CacheReleaser releaser;
+      (void)releaser;
+    }
+    // else slot freed from destructor of other thread-local object
+    // after releaser was destroyed, it is kept until thread exit
+  }
+
+  // |this| is |instance()|, constructor is private
+  FreeSlot* popLocal()
+  {
+    if (!localHead_) {
+      registerReleaser();
+      FreeSlot* batch = popBatch();
+      localHead_ = batch;
+      localSize_ = batch->batchSize;
+    }
+    FreeSlot* slot = localHead_;
+    localHead_ = slot->next;
+    --localSize_;
+    return slot;
+  }
+
+  void pushLocal(FreeSlot* slot)
+  {
+    if (localSize_ == 0) {
+      registerReleaser();
+    }
+    slot->next = localHead_;
+    localHead_ = slot;
+    ++localSize_;
+    if (localSize_ >= 2 * kBatchSize) {
+      pushBatch(detachLocalBatch(kBatchSize));
+    }
+  }
+
+  static FreeSlot* detachLocalBatch(size_t count)
+  {
+    FreeSlot* first = localHead_;
+    FreeSlot* last = localHead_;
+    for (size_t i = 1; i < count; ++i) {
+      last = last->next;
+    }
+    localHead_ = last->next;
+    localSize_ -= count;
+    last->next = nullptr;
+    first->batchSize = count;
+    return first;
+  }
+
+  ObjectPool() = default;
+
+  void pushBatch(FreeSlot* batch)
+  {
+    pushBatches(batch, batch);
+  }
+
+  // links batches from |first| to |last| into shared stack
+  void pushBatches(FreeSlot* first, FreeSlot* last)
+  {
+    std::lock_guard<std::mutex> lock(batchesMutex_);
+    last->nextBatch = batches_;
+    batches_ = first;
+  }
+
+  FreeSlot* popBatch()
+  {
+    {
+      std::lock_guard<std::mutex> lock(batchesMutex_);
+      FreeSlot* batch = batches_;
+      if (batch) {
+        batches_ = batch->nextBatch;
+        batch->nextBatch = nullptr;
+        return batch;
+      }
+    }
+    // slab is carved outside of lock
+    return allocateSlab();
+  }
+
+  // returns first batch of new slab,
+  // other batches are pushed into shared stack
+  FreeSlot* allocateSlab()
+  {
+    Slab* slab = new Slab;
+    // keeps slabs reachable (i.e. for leak checkers)
+    slab->next = slabs_.load(std::memory_order_relaxed);
+    while (!slabs_.compare_exchange_weak(slab->next, slab
+             , std::memory_order_release
+             , std::memory_order_relaxed)) {
+    }
+    slabCount_.fetch_add(1, std::memory_order_relaxed);
+
+    FreeSlot* firstBatch = nullptr;
+    FreeSlot* lastBatch = nullptr;
+    for (size_t begin = 0; begin < kSlabSlots; begin += kBatchSize) {
+      const size_t end = std::min(begin + kBatchSize, kSlabSlots);
+      FreeSlot* batch = nullptr;
+      for (size_t i = end; i-- > begin; ) {
+        FreeSlot* slot = ::new (static_cast<void*>(&slab->slots[i]))
+          FreeSlot{};
+        slot->next = batch;
+        batch = slot;
+      }
+      batch->batchSize = end - begin;
+      if (lastBatch) {
+        lastBatch->nextBatch = batch;
+      } else {
+        firstBatch = batch;
+      }
+      lastBatch = batch;
+    }
+
+    FreeSlot* rest = firstBatch->nextBatch;
+    if (rest) {
+      pushBatches(rest, lastBatch);
+    }
+    firstBatch->nextBatch = nullptr;
+    return firstBatch;
+  }
+
+  std::mutex batchesMutex_;
+
+  // guarded by |batchesMutex_|
+  FreeSlot* batches_ = nullptr;
+
+  std::atomic<Slab*> slabs_{nullptr};
+
+  std::atomic<size_t> slabCount_{0};
+
+  // free list of calling thread,
+  // plain values (trivially destructible), so they remain usable
+  // after |CacheReleaser| is destroyed on thread exit
+  static thread_local FreeSlot* localHead_;
+
+  static thread_local size_t localSize_;
+
+  static thread_local LocalState localState_;
+};
+
+template<typename T, size_t kBatchSize, size_t kSlabSlots>
+thread_local typename ObjectPool<T, kBatchSize, kSlabSlots>::FreeSlot*
+  ObjectPool<T, kBatchSize, kSlabSlots>::localHead_ = nullptr;
+
+template<typename T, size_t kBatchSize, size_t kSlabSlots>
+thread_local size_t
+  ObjectPool<T, kBatchSize, kSlabSlots>::localSize_ = 0;
+
+template<typename T, size_t kBatchSize, size_t kSlabSlots>
+thread_local typename ObjectPool<T, kBatchSize, kSlabSlots>::LocalState
+  ObjectPool<T, kBatchSize, kSlabSlots>::localState_
+    = LocalState::kUnregistered;
+
+} // namespace pool
+} // namespace flex_meta
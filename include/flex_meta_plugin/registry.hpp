@@ -0,0 +1,202 @@
+#pragma once
+
+/// \note Runtime support for code generated by `make_registry`.
+/// Header-only and depends only on the standard library.
+///
+/// `make_registry` emits one |RecordEntry| per record
+/// and puts pointer to it into `flex_meta_registry` linker section,
+/// so linker builds list of all records from all translation units
+/// (no static constructors, no registration code).
+/// Index over that list is sorted once on first use
+/// (function-local static) and never changes after that,
+/// so lookups by name or type id are lock-free from any thread.
+///
+/// Type id is FNV-1a (64 bit) of fully qualified record name,
+/// computed by plugin, see |typeIdOf|.
+///
+/// Registry contains records linked into module (executable or
+/// shared library) that calls lookup functions.
+
+#include <flex_meta_plugin/dynamic_access.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__APPLE__)
+#define FLEX_META_REGISTRY_SECTION \
+  __attribute__((used, section("__DATA,flex_meta_reg")))
+#elif defined(__ELF__)
+#define FLEX_META_REGISTRY_SECTION \
+  __attribute__((used, section("flex_meta_registry")))
+#else
+#error "flex_meta registry requires ELF or Mach-O linker sections"
+#endif
+
+namespace flex_meta {
+namespace registry {
+
+struct RecordEntry {
+  // fully qualified name, i.e. "ns::Record"
+  const char* name;
+
+  uint64_t typeId;
+
+  // empty table if record is not annotated with `make_dynamic`
+  ::flex_meta::dynamic::FieldTable (*fields)();
+};
+
+} // namespace registry
+} // namespace flex_meta
+
+// defined by linker if at least one entry exists in module
+#if defined(__APPLE__)
+extern const ::flex_meta::registry::RecordEntry* const
+  flex_meta_registry_begin
+    __asm("section$start$__DATA$flex_meta_reg")
+    __attribute__((weak_import, visibility("hidden")));
+extern const ::flex_meta::registry::RecordEntry* const
+  flex_meta_registry_end
+    __asm("section$end$__DATA$flex_meta_reg")
+    __attribute__((weak_import, visibility("hidden")));
+#else
+extern "C" const ::flex_meta::registry::RecordEntry* const
+  __start_flex_meta_registry[]
+    __attribute__((weak, visibility("hidden")));
+extern "C" const ::flex_meta::registry::RecordEntry* const
+  __stop_flex_meta_registry[]
+    __attribute__((weak, visibility("hidden")));
+#endif
+
+namespace flex_meta {
+namespace registry {
+
+// same hash as used by plugin for |RecordEntry::typeId|
+constexpr uint64_t typeIdOf(std::string_view qualifiedName)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : qualifiedName) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+template<typename Record, typename = void>
+struct HasDynamicFields : std::false_type {};
+
+template<typename Record>
+struct HasDynamicFields<Record
+  , std::void_t<decltype(Record::dynamic_fields())>>
+  : std::true_type {};
+
+// instantiated when |Record| is complete,
+// so it can be referenced from inside of record
+template<typename Record>
+::flex_meta::dynamic::FieldTable fieldsOf()
+{
+  if constexpr (HasDynamicFields<Record>::value) {
+    return Record::dynamic_fields();
+  } else {
+    return ::flex_meta::dynamic::FieldTable{nullptr, 0};
+  }
+}
+
+class Registry {
+public:
+  // built once, immutable after that,
+  // never destroyed, so lookups work from destructors of static objects
+  static const Registry& instance()
+  {
+    static const Registry* registry = new Registry;
+    return *registry;
+  }
+
+  // returns nullptr if record not found
+  const RecordEntry* findByName(std::string_view name) const
+  {
+    auto it = std::lower_bound(byName_.begin(), byName_.end(), name
+      , [](const RecordEntry* entry, std::string_view name) {
+          return std::string_view(entry->name) < name;
+        });
+    if (it == byName_.end() || std::string_view((*it)->name) != name) {
+      return nullptr;
+    }
+    return *it;
+  }
+
+  // returns nullptr if record not found
+  const RecordEntry* findById(uint64_t typeId) const
+  {
+    auto it = std::lower_bound(byId_.begin(), byId_.end(), typeId
+      , [](const RecordEntry* entry, uint64_t typeId) {
+          return entry->typeId < typeId;
+        });
+    if (it == byId_.end() || (*it)->typeId != typeId) {
+      return nullptr;
+    }
+    return *it;
+  }
+
+  // sorted by name
+  const std::vector<const RecordEntry*>& entries() const
+  {
+    return byName_;
+  }
+
+private:
+  Registry()
+  {
+#if defined(__APPLE__)
+    const RecordEntry* const* begin = &flex_meta_registry_begin;
+    const RecordEntry* const* end = &flex_meta_registry_end;
+#else
+    const RecordEntry* const* begin = __start_flex_meta_registry;
+    const RecordEntry* const* end = __stop_flex_meta_registry;
+#endif
+    if (begin && end) {
+      for (const RecordEntry* const* it = begin; it != end; ++it) {
+        // section may contain padding
+        if (*it) {
+          byName_.push_back(*it);
+        }
+      }
+    }
+    // the same entry may be referenced more than once
+    std::sort(byName_.begin(), byName_.end()
+      , std::less<const RecordEntry*>());
+    byName_.erase(std::unique(byName_.begin(), byName_.end())
+      , byName_.end());
+
+    std::stable_sort(byName_.begin(), byName_.end()
+      , [](const RecordEntry* lhs, const RecordEntry* rhs) {
+          return std::string_view(lhs->name) < std::string_view(rhs->name);
+        });
+    byId_ = byName_;
+    std::stable_sort(byId_.begin(), byId_.end()
+      , [](const RecordEntry* lhs, const RecordEntry* rhs) {
+          return lhs->typeId < rhs->typeId;
+        });
+  }
+
+  std::vector<const RecordEntry*> byName_;
+
+  std::vector<const RecordEntry*> byId_;
+};
+
+inline const RecordEntry* findRecord(std::string_view name)
+{
+  return Registry::instance().findByName(name);
+}
+
+inline const RecordEntry* findRecord(uint64_t typeId)
+{
+  return Registry::instance().findById(typeId);
+}
+
+} // namespace registry
+} // namespace flex_meta
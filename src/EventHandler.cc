@@ -54,6 +54,21 @@ FlexMetaEventHandler::~FlexMetaEventHandler()
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 }
 
+void FlexMetaEventHandler::SetSkipSystemHeaders(bool skipSystemHeaders)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  recordFilter_.SetSkipSystemHeaders(skipSystemHeaders);
+}
+
+void FlexMetaEventHandler::SetSkipPathPatterns(
+  std::vector<std::string> patterns)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  recordFilter_.SetSkipPathPatterns(std::move(patterns));
+}
+
 void FlexMetaEventHandler::StringCommand(
   const ::plugin::ToolPlugin::Events::StringCommand& event)
 {
@@ -84,11 +99,14 @@ void FlexMetaEventHandler::RegisterAnnotationMethods(
                "plugin::FlexMetaEventHandler::handle_event(RegisterAnnotationMethods)");
 
 #if defined(CLING_IS_ON)
-  DCHECK(clingInterpreter_);
+  VLOG_IF(9, !clingInterpreter_)
+    << kPluginDebugLogName
+    << " registering rules without Cling interpreter";
 #endif // CLING_IS_ON
 
   tooling_ = std::make_unique<MetaTooling>(
     event
+    , &recordFilter_
 #if defined(CLING_IS_ON)
     , clingInterpreter_
 #endif // CLING_IS_ON
@@ -111,6 +129,61 @@ void FlexMetaEventHandler::RegisterAnnotationMethods(
         &MetaTooling::make_reflect
         , base::Unretained(tooling_.get()));
   }
+
+  {
+    VLOG(9)
+      << "registered source transform rule:"
+         " make_columnar";
+    CHECK(tooling_);
+    sourceTransformRules["make_columnar"] =
+      base::BindRepeating(
+        &MetaTooling::make_columnar
+        , base::Unretained(tooling_.get()));
+  }
+
+  {
+    VLOG(9)
+      << "registered source transform rule:"
+         " make_pool";
+    CHECK(tooling_);
+    sourceTransformRules["make_pool"] =
+      base::BindRepeating(
+        &MetaTooling::make_pool
+        , base::Unretained(tooling_.get()));
+  }
+
+  {
+    VLOG(9)
+      << "registered source transform rule:"
+         " make_validate";
+    CHECK(tooling_);
+    sourceTransformRules["make_validate"] =
+      base::BindRepeating(
+        &MetaTooling::make_validate
+        , base::Unretained(tooling_.get()));
+  }
+
+  {
+    VLOG(9)
+      << "registered source transform rule:"
+         " make_dynamic";
+    CHECK(tooling_);
+    sourceTransformRules["make_dynamic"] =
+      base::BindRepeating(
+        &MetaTooling::make_dynamic
+        , base::Unretained(tooling_.get()));
+  }
+
+  {
+    VLOG(9)
+      << "registered source transform rule:"
+         " make_registry";
+    CHECK(tooling_);
+    sourceTransformRules["make_registry"] =
+      base::BindRepeating(
+        &MetaTooling::make_registry
+        , base::Unretained(tooling_.get()));
+  }
 }
 
 #if defined(CLING_IS_ON)
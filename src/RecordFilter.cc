@@ -0,0 +1,71 @@
+#include <flex_meta_plugin/RecordFilter.hpp> // IWYU pragma: associated
+
+#include <llvm/ADT/StringRef.h>
+
+#include <base/logging.h>
+
+namespace plugin {
+
+RecordFilter::RecordFilter()
+{
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+RecordFilter::~RecordFilter()
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void RecordFilter::SetSkipSystemHeaders(bool skipSystemHeaders)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  skipSystemHeaders_ = skipSystemHeaders;
+}
+
+void RecordFilter::SetSkipPathPatterns(std::vector<std::string> patterns)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  skipPathPatterns_ = std::move(patterns);
+}
+
+bool RecordFilter::ShouldProcess(
+  const clang::Decl* record
+  , const clang::SourceManager& sourceManager)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(record);
+
+  if (!skipSystemHeaders_ && skipPathPatterns_.empty()) {
+    return true;
+  }
+
+  const clang::SourceLocation location
+    = sourceManager.getExpansionLoc(record->getLocation());
+  const llvm::StringRef path = sourceManager.getFilename(location);
+
+  bool skipped
+    = skipSystemHeaders_ && sourceManager.isInSystemHeader(location);
+  if (!skipped) {
+    for (const std::string& pattern : skipPathPatterns_) {
+      if (path.find(pattern) != llvm::StringRef::npos) {
+        skipped = true;
+        break;
+      }
+    }
+  }
+
+  if (skipped && reportedPaths_.insert(path.str()).second) {
+    LOG(WARNING)
+      << "annotated records from file "
+      << path.str()
+      << " are skipped by all rules"
+         " (see skip_system_headers and skip_path_patterns"
+         " in plugin configuration)";
+  }
+
+  return !skipped;
+}
+
+} // namespace plugin
@@ -19,8 +19,12 @@
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/QualTypeNames.h>
 #include <clang/Lex/Preprocessor.h>
 
+#include <llvm/ADT/APFloat.h>
+
 #include <base/cpu.h>
 #include <base/bind.h>
 #include <base/command_line.h>
@@ -28,55 +32,77 @@
 #include <base/debug/stack_trace.h>
 #include <base/memory/ptr_util.h>
 #include <base/sequenced_task_runner.h>
+#include <base/files/file.h>
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/strings/string_number_conversions.h>
+#include <base/strings/string_piece.h>
+#include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
+#include <base/strings/stringprintf.h>
 #include <base/trace_event/trace_event.h>
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace plugin {
 
 namespace {
 
 static const std::string kGenAttrToken = "{gen};{attr};";
 static const std::string kAttrReflectableFlag = "reflectable";
+static const std::string kAttrDictionaryFlag = "dictionary";
 
 // parse declaration and find all annotations
 // that start with kGenAttrToken
-// return true if declaration is marked with
-// "reflectable" attriblute i.e.
-// __attribute__((annotate("{gen};{attr};reflectable;")))
-static const bool isReflectable(clang::DeclaratorDecl* decl)
+// return tokens listed after kGenAttrToken i.e.
+// {"reflectable", "dictionary"} for
+// __attribute__((annotate("{gen};{attr};reflectable;dictionary;")))
+static std::vector<std::string> getGenAttrTokens(
+  const clang::Decl* decl)
 {
-  bool res = false;
-  if ( auto annotate = decl->getAttr<clang::AnnotateAttr>() )
+  std::vector<std::string> tokens;
+  for (const clang::AnnotateAttr* annotate
+         : decl->specific_attrs<clang::AnnotateAttr>())
   {
-    std::string annotationCode =
-      annotate->getAnnotation().str();
+    llvm::StringRef annotationCode =
+      annotate->getAnnotation();
     VLOG(9)
       << "annotation code: "
-      << annotationCode;
-    const bool startsWithGen =
-      annotationCode.rfind(kGenAttrToken, 0) == 0;
-    annotationCode.erase(0, kGenAttrToken.size());
-    if (startsWithGen) {
-      std::string delimiter = ";";
-      size_t pos = 0;
-      std::string token;
-      while ((pos = annotationCode.find(delimiter)) != std::string::npos) {
-        token = annotationCode.substr(0, pos);
-        VLOG(9)
-          << "isReflectable token "
-          << token;
-        if(token == kAttrReflectableFlag) {
-          res = true;
-          break;
-        }
-        annotationCode.erase(0, pos + delimiter.length());
-      }
-      if(!annotationCode.empty()
-         && annotationCode == kAttrReflectableFlag) {
-        res = true;
-      }
+      << annotationCode.str();
+    if (!annotationCode.startswith(kGenAttrToken)) {
+      continue;
+    }
+    annotationCode = annotationCode.drop_front(kGenAttrToken.size());
+    llvm::SmallVector<llvm::StringRef, 4> parts;
+    annotationCode.split(parts, ';', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    for (llvm::StringRef part : parts) {
+      tokens.push_back(part.trim().str());
     }
   }
+  return tokens;
+}
+
+static bool hasGenAttrFlag(
+  const clang::Decl* decl, const std::string& flag)
+{
+  const std::vector<std::string> tokens = getGenAttrTokens(decl);
+  return std::find(tokens.begin(), tokens.end(), flag) != tokens.end();
+}
+
+// return true if declaration is marked with
+// "reflectable" attriblute i.e.
+// __attribute__((annotate("{gen};{attr};reflectable;")))
+static const bool isReflectable(const clang::DeclaratorDecl* decl)
+{
+  const bool res = hasGenAttrFlag(decl, kAttrReflectableFlag);
 
   VLOG(9)
     << "isReflectable attr() "
@@ -86,6 +112,464 @@ static const bool isReflectable(clang::DeclaratorDecl* decl)
   return res;
 }
 
+// how field can be stored by `make_columnar`
+enum class ColumnKind {
+  kUnsupported,
+  // arithmetic or enum type, stored in typed contiguous column
+  kNumeric,
+  // std::string, stored as offsets + bytes
+  // (or as dictionary indices if field has "dictionary" attribute)
+  kString,
+};
+
+static ColumnKind getColumnKind(clang::QualType type)
+{
+  const clang::QualType canonical = type.getCanonicalType();
+  if (canonical->isEnumeralType()) {
+    return ColumnKind::kNumeric;
+  }
+  if (canonical->isBuiltinType()
+      && (canonical->isIntegerType() || canonical->isRealFloatingType())
+      && !canonical->isSpecificBuiltinType(clang::BuiltinType::LongDouble)
+      && !canonical->isSpecificBuiltinType(clang::BuiltinType::Int128)
+      && !canonical->isSpecificBuiltinType(clang::BuiltinType::UInt128))
+  {
+    return ColumnKind::kNumeric;
+  }
+  if (const clang::CXXRecordDecl* decl
+        = canonical->getAsCXXRecordDecl())
+  {
+    const auto* spec
+      = llvm::dyn_cast<clang::ClassTemplateSpecializationDecl>(decl);
+    if (spec
+        && decl->isInStdNamespace()
+        && decl->getName() == "basic_string")
+    {
+      const clang::TemplateArgumentList& args = spec->getTemplateArgs();
+      if (args.size() > 0
+          && args[0].getKind() == clang::TemplateArgument::Type
+          && args[0].getAsType()->isCharType())
+      {
+        return ColumnKind::kString;
+      }
+    }
+  }
+  return ColumnKind::kUnsupported;
+}
+
+static const std::string kOrderArg = "order";
+static const std::string kOrderSorted = "sorted";
+static const std::string kOrderDeclaration = "declaration";
+// make_reflect(profile_fields = "true")
+static const std::string kProfileFieldsArg = "profile_fields";
+// make_reflect(profile_data = "path/to/dumped/profile")
+static const std::string kProfileDataArg = "profile_data";
+
+// fields that together take this share of all accesses are hot
+static const double kHotFieldsAccessShare = 0.9;
+
+// make_pool(reset = "true")
+static const std::string kPoolResetArg = "reset";
+
+// i.e. "range(0,100)" or "range(-1.5, 1.5)", bounds are inclusive
+static const std::string kAttrRangePrefix = "range(";
+static const std::string kAttrRangeSuffix = ")";
+
+// bounds of "range(min,max)" field attribute
+// as written in annotation, emitted into generated code as is
+struct RangeConstraint {
+  std::string min;
+  std::string max;
+};
+
+// returns false if field has no "range(min,max)" attribute
+// or attribute is malformed
+static bool getRangeConstraint(
+  const clang::FieldDecl* field
+  , RangeConstraint* range)
+{
+  DCHECK(range);
+  for (const std::string& token : getGenAttrTokens(field)) {
+    if (!base::StartsWith(token, kAttrRangePrefix
+          , base::CompareCase::SENSITIVE)
+        || !base::EndsWith(token, kAttrRangeSuffix
+          , base::CompareCase::SENSITIVE))
+    {
+      continue;
+    }
+    const std::string bounds = token.substr(kAttrRangePrefix.size()
+      , token.size() - kAttrRangePrefix.size() - kAttrRangeSuffix.size());
+    const std::vector<std::string> parts
+      = base::SplitString(bounds, ","
+          , base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+    double min = 0;
+    double max = 0;
+    if (parts.size() != 2
+        || !base::StringToDouble(parts[0], &min)
+        || !base::StringToDouble(parts[1], &max)
+        || min > max)
+    {
+      LOG(WARNING)
+        << "malformed attribute "
+        << token
+        << " of field "
+        << field->getNameAsString()
+        << ", expected range(min,max) with min <= max";
+      return false;
+    }
+    range->min = parts[0];
+    range->max = parts[1];
+    return true;
+  }
+  return false;
+}
+
+// bounds of |RangeConstraint| as literals of field type,
+// empty literal means that check is redundant
+// (bound is the limit of field type)
+struct RangeLiterals {
+  std::string min;
+  std::string max;
+};
+
+// returns false if field type is not supported
+// or any bound is not representable in field type
+// (i.e. range(0,300) of uint8_t field, range(0.5,10) of int field)
+static bool getRangeLiterals(
+  const RangeConstraint& range
+  , clang::QualType type
+  , const clang::ASTContext& context
+  , RangeLiterals* literals)
+{
+  DCHECK(literals);
+  type = type.getCanonicalType();
+  if (type->isRealFloatingType()) {
+    // largest finite value of field type, +inf for wider than double
+    llvm::APFloat largest
+      = llvm::APFloat::getLargest(context.getFloatTypeSemantics(type));
+    bool losesInfo = false;
+    largest.convert(llvm::APFloat::IEEEdouble()
+      , llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+    const double limit = largest.convertToDouble();
+    double min = 0;
+    double max = 0;
+    if (!base::StringToDouble(range.min, &min)
+        || !base::StringToDouble(range.max, &max)
+        || !(std::fabs(min) <= limit) || !(std::fabs(max) <= limit))
+    {
+      return false;
+    }
+    // NaN must fail both checks, so none is dropped
+    literals->min = range.min;
+    literals->max = range.max;
+    return true;
+  }
+  if (!type->isIntegerType() || type->isBooleanType()
+      || type->isEnumeralType())
+  {
+    return false;
+  }
+  const uint64_t width = context.getIntWidth(type);
+  if (width == 0 || width > 64) {
+    return false;
+  }
+  if (type->isSignedIntegerType()) {
+    const int64_t typeMax = width == 64
+      ? std::numeric_limits<int64_t>::max()
+      : static_cast<int64_t>((uint64_t{1} << (width - 1)) - 1);
+    const int64_t typeMin = -typeMax - 1;
+    int64_t min = 0;
+    int64_t max = 0;
+    // rejects fractional bounds
+    if (!base::StringToInt64(range.min, &min)
+        || !base::StringToInt64(range.max, &max)
+        || min < typeMin || max > typeMax)
+    {
+      return false;
+    }
+    literals->min = min == typeMin ? "" : base::StringPrintf(
+      "%" PRId64 "LL", min);
+    literals->max = max == typeMax ? "" : base::StringPrintf(
+      "%" PRId64 "LL", max);
+    return true;
+  }
+  const uint64_t typeMax = width == 64
+    ? std::numeric_limits<uint64_t>::max()
+    : (uint64_t{1} << width) - 1;
+  uint64_t min = 0;
+  uint64_t max = 0;
+  // rejects fractional and negative bounds
+  if (base::StartsWith(range.min, "-", base::CompareCase::SENSITIVE)
+      || base::StartsWith(range.max, "-", base::CompareCase::SENSITIVE)
+      || !base::StringToUint64(range.min, &min)
+      || !base::StringToUint64(range.max, &max)
+      || max > typeMax)
+  {
+    return false;
+  }
+  // `value >= 0` is always true for unsigned value (-Wtype-limits)
+  literals->min = min == 0 ? "" : base::StringPrintf(
+    "%" PRIu64 "ULL", min);
+  literals->max = max == typeMax ? "" : base::StringPrintf(
+    "%" PRIu64 "ULL", max);
+  return true;
+}
+
+// returns value of annotation argument without quotes,
+// i.e. "declaration" for make_reflect(order = "declaration")
+// returns empty string if argument not found
+static std::string getAnnotationArg(
+  const clang_utils::SourceTransformOptions& sourceTransformOptions
+  , const std::string& name)
+{
+  for (const auto& arg
+         : sourceTransformOptions.func_with_args.parsed_func_.args_.as_vec_)
+  {
+    if (arg.name_ == name) {
+      std::string value;
+      base::TrimString(arg.value_, " \t\"", &value);
+      return value;
+    }
+  }
+  return std::string{};
+}
+
+// FNV-1a, unlike std::hash result is the same
+// on all platforms and standard library implementations
+static uint64_t fnv1a64(const std::string& data)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// prints fully qualified type name using fixed printing policy,
+// so type spelling does not depend on how type was written
+// in source code (i.e. `string` after `using namespace std;`).
+// Type aliases are preserved, because canonical types
+// differ between standard library implementations
+// (i.e. `std::__cxx11::basic_string<char>`).
+// Anonymous records and lambdas are printed without source location
+// (i.e. `(anonymous struct)`, not `(anonymous struct at /path/a.h:1:1)`),
+// so name does not depend on path or line of declaration.
+// Other flags of policy do not print locations or file paths.
+static std::string getNormalizedTypeName(
+  clang::QualType type, const clang::ASTContext& context)
+{
+  clang::PrintingPolicy policy(context.getLangOpts());
+  policy.SuppressTagKeyword = true;
+  policy.SuppressUnwrittenScope = true;
+  policy.AnonymousTagLocations = false;
+  policy.Bool = true;
+  return clang::TypeName::getFullyQualifiedName(
+    type.getUnqualifiedType(), context, policy
+    , /*WithGlobalNsPrefix*/ false);
+}
+
+// name to type pairs in declaration order,
+// later declaration with the same name (i.e. overloaded method)
+// replaces type of previous one
+struct ReflectEntries {
+  void set(const std::string& name, std::string type)
+  {
+    auto it = positions.find(name);
+    if (it != positions.end()) {
+      items[it->second].second = std::move(type);
+      return;
+    }
+    positions.emplace(name, items.size());
+    items.emplace_back(name, std::move(type));
+  }
+
+  void sortByName()
+  {
+    std::sort(items.begin(), items.end()
+      , [](const auto& lhs, const auto& rhs) {
+          return lhs.first < rhs.first;
+        });
+    positions.clear();
+  }
+
+  std::vector<std::pair<std::string, std::string>> items;
+
+  std::unordered_map<std::string, size_t> positions;
+};
+
+static void appendReflectMap(
+  std::string& output
+  , const std::string& indent
+  , const std::string& name
+  , const ReflectEntries& entries)
+{
+  // inline: in-class initializer for static member of non-literal type
+  output.append(indent
+                  + "inline static std::map<std::string, std::string> "
+                  + name);
+  output.append(" = {");
+  output.append("\n");
+  for (size_t i = 0; i < entries.items.size(); ++i) {
+    output.append(indent + indent
+                    + "{ ");
+    output.append("\"" + entries.items[i].first + "\"");
+    output.append(", ");
+    output.append("\"" + entries.items[i].second + "\"");
+    output.append(" }");
+    if (i + 1 != entries.items.size()) {
+      output.append(",");
+    }
+    output.append("\n");
+  }
+  output.append(indent
+                  + "};");
+  output.append("\n");
+}
+
+// emits accessors that count field reads if
+// FLEX_META_PROFILE_FIELDS is defined,
+// see <flex_meta_plugin/field_profile.hpp>
+static void appendProfiledAccessors(
+  std::string& output
+  , const std::string& indent
+  , const std::string& recordName
+  , const std::string& qualifiedRecordName
+  , const std::vector<std::string>& fieldNames)
+{
+  output.append(indent
+                  + "static constexpr const char* flex_meta_profile_record = ");
+  output.append("\"" + qualifiedRecordName + "\";");
+  output.append("\n");
+  output.append(indent
+                  + "static constexpr const char* flex_meta_profile_fields[] = {");
+  output.append("\n");
+  for (size_t i = 0; i < fieldNames.size(); ++i) {
+    output.append(indent + indent
+                    + "\"" + fieldNames[i] + "\"");
+    if (i + 1 != fieldNames.size()) {
+      output.append(",");
+    }
+    output.append("\n");
+  }
+  output.append(indent
+                  + "};");
+  output.append("\n");
+
+  for (size_t i = 0; i < fieldNames.size(); ++i) {
+    const std::string& field = fieldNames[i];
+    const std::string fieldType
+      = "decltype(" + recordName + "::" + field + ")";
+    const std::string counter
+      = "::flex_meta::profile::FieldProfile<" + recordName
+        + ">::hit(" + std::to_string(i) + ");";
+    const struct {
+      const char* prefix;
+      const char* returnTypePrefix;
+      const char* qualifier;
+    } accessors[] = {
+      {"reflect_get_", "const ", " const"},
+      {"reflect_ref_", "", ""},
+    };
+    for (const auto& accessor : accessors) {
+      output.append("\n");
+      output.append(indent
+                      + accessor.returnTypePrefix + fieldType + "& "
+                      + accessor.prefix + field + "()"
+                      + accessor.qualifier);
+      output.append("\n");
+      output.append(indent + "{");
+      output.append("\n");
+      output.append("#if defined(FLEX_META_PROFILE_FIELDS)");
+      output.append("\n");
+      output.append(indent + "  " + counter);
+      output.append("\n");
+      output.append("#endif // FLEX_META_PROFILE_FIELDS");
+      output.append("\n");
+      output.append(indent + "  return " + field + ";");
+      output.append("\n");
+      output.append(indent + "}");
+      output.append("\n");
+    }
+  }
+}
+
+static void appendFieldNameList(
+  std::string& output
+  , const std::string& indent
+  , const std::string& name
+  , const std::vector<std::string>& fieldNames)
+{
+  // nullptr-terminated, so list may be empty
+  output.append(indent
+                  + "static constexpr const char* " + name + "[] = {");
+  output.append("\n");
+  for (const std::string& field : fieldNames) {
+    output.append(indent + indent
+                    + "\"" + field + "\",");
+    output.append("\n");
+  }
+  output.append(indent + indent
+                  + "nullptr");
+  output.append("\n");
+  output.append(indent
+                  + "};");
+  output.append("\n");
+}
+
+// emits fields ordered by access count (hottest first)
+// split into hot and cold parts,
+// hot fields are candidates for keeping together
+// at the beginning of record
+static void appendHotColdFields(
+  std::string& output
+  , const std::string& indent
+  , const std::string& qualifiedRecordName
+  , const std::vector<std::string>& fieldNames
+  , const std::unordered_map<std::string, uint64_t>& accessCounts)
+{
+  std::vector<std::pair<std::string, uint64_t>> byHotness;
+  uint64_t totalCount = 0;
+  for (const std::string& field : fieldNames) {
+    auto it = accessCounts.find(field);
+    const uint64_t count = it == accessCounts.end() ? 0 : it->second;
+    byHotness.emplace_back(field, count);
+    totalCount += count;
+  }
+  // ties keep declaration order
+  std::stable_sort(byHotness.begin(), byHotness.end()
+    , [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+      });
+
+  std::vector<std::string> hotFields;
+  std::vector<std::string> coldFields;
+  uint64_t hotCount = 0;
+  for (const auto& [field, count] : byHotness) {
+    if (count != 0
+        && static_cast<double>(hotCount)
+             < kHotFieldsAccessShare * static_cast<double>(totalCount))
+    {
+      hotFields.push_back(field);
+      hotCount += count;
+    } else {
+      coldFields.push_back(field);
+    }
+  }
+
+  LOG(INFO)
+    << "make_reflect: "
+    << qualifiedRecordName
+    << " has "
+    << hotFields.size()
+    << " hot and "
+    << coldFields.size()
+    << " cold reflectable fields";
+
+  appendFieldNameList(output, indent, "flex_meta_hot_fields", hotFields);
+  output.append("\n");
+  appendFieldNameList(output, indent, "flex_meta_cold_fields", coldFields);
+}
 
 static std::string dumpAccessSpecifier(clang::AccessSpecifier AS) {
   switch (AS) {
@@ -104,16 +588,51 @@ static std::string dumpAccessSpecifier(clang::AccessSpecifier AS) {
   return "";
 }
 
+// emits overload of |name| that accepts any contiguous range
+// of records (std::vector, std::array, span) and forwards it to
+// `name(const Record* records, std::size_t count, args)`,
+// |params| and |args| are trailing parameters and arguments of |name|
+static void appendRangeOverload(
+  std::string& output
+  , const std::string& indent
+  , const std::string& returnType
+  , const std::string& name
+  , const std::string& params
+  , const std::string& args)
+{
+  output.append(indent
+                  + "template<typename Records>");
+  output.append("\n");
+  output.append(indent
+                  + "static " + returnType + " " + name
+                  + "(const Records& records, " + params + ")");
+  output.append("\n");
+  output.append(indent + "{");
+  output.append("\n");
+  output.append(indent + indent
+                  + "return " + name + "(std::data(records), "
+                    "std::size(records), " + args + ");");
+  output.append("\n");
+  output.append(indent + "}");
+  output.append("\n");
+}
+
 } // namespace
 
 MetaTooling::MetaTooling(
   const ::plugin::ToolPlugin::Events::RegisterAnnotationMethods& event
+  , RecordFilter* recordFilter
 #if defined(CLING_IS_ON)
   , ::cling_utils::ClingInterpreter* clingInterpreter
 #endif // CLING_IS_ON
-) : clingInterpreter_(clingInterpreter)
+) : recordFilter_(recordFilter)
+#if defined(CLING_IS_ON)
+  , clingInterpreter_(clingInterpreter)
+#endif // CLING_IS_ON
 {
-  DCHECK(clingInterpreter_);
+  DCHECK(recordFilter_);
+  // |clingInterpreter_| may be nullptr:
+  // none of rules requires Cling, see `requires_cling` in plugin config
 
   DETACH_FROM_SEQUENCE(sequence_checker_);
 
@@ -130,6 +649,133 @@ MetaTooling::~MetaTooling()
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 }
 
+const clang::CXXRecordDecl* MetaTooling::getRecordToTransform(
+  const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  clang::CXXRecordDecl const *record =
+      sourceTransformOptions.matchResult.Nodes
+      .getNodeAs<clang::CXXRecordDecl>("bind_gen");
+
+  if (!record) {
+    return nullptr;
+  }
+
+  DCHECK(sourceTransformOptions.matchResult.SourceManager);
+  if (!recordFilter_->ShouldProcess(record
+        , *sourceTransformOptions.matchResult.SourceManager))
+  {
+    return nullptr;
+  }
+
+  return record;
+}
+
+clang_utils::SourceTransformResult MetaTooling::transformRecord(
+  const char* ruleName
+  , const clang_utils::SourceTransformOptions& sourceTransformOptions
+  , AppendMembersCallback appendMembers)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  VLOG(9)
+    << ruleName
+    << " called...";
+
+  clang::CXXRecordDecl const *record =
+      getRecordToTransform(sourceTransformOptions);
+
+  if (!record) {
+    return clang_utils::SourceTransformResult{nullptr};
+  }
+
+  const std::string recordName = record->getNameAsString();
+  if (recordName.empty()) {
+    LOG(WARNING)
+      << ruleName
+      << " does not support anonymous records";
+    return clang_utils::SourceTransformResult{nullptr};
+  }
+
+  std::string output{};
+  output.append("\n");
+  output.append("  public:");
+  output.append("\n");
+
+  if (!appendMembers(record, recordName, "    ", output)) {
+    return clang_utils::SourceTransformResult{nullptr};
+  }
+
+  auto locEnd = record->getLocEnd();
+
+  // add generated members at the end of the C++ record
+  sourceTransformOptions.rewriter.InsertText(locEnd, output,
+    /*InsertAfter=*/true, /*IndentNewLines*/ false);
+
+  return clang_utils::SourceTransformResult{nullptr};
+}
+
+const MetaTooling::FieldAccessProfile& MetaTooling::loadFieldProfile(
+  const std::string& path)
+{
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // profile may be rewritten by next profiling run
+  // while plugin is loaded, so reload it if it changed
+  base::File::Info fileInfo;
+  if (!base::GetFileInfo(base::FilePath{path}, &fileInfo)) {
+    fileInfo.last_modified = base::Time();
+  }
+
+  LoadedFieldProfile& loaded = fieldProfiles_[path];
+  if (loaded.loaded
+      && loaded.lastModified == fileInfo.last_modified)
+  {
+    return loaded.profile;
+  }
+  loaded.loaded = true;
+  loaded.lastModified = fileInfo.last_modified;
+
+  FieldAccessProfile& profile = loaded.profile;
+  profile.clear();
+
+  std::string contents;
+  if (!base::ReadFileToString(base::FilePath{path}, &contents)) {
+    LOG(WARNING)
+      << "make_reflect: unable to read profile data from "
+      << path;
+    return profile;
+  }
+
+  // see <flex_meta_plugin/field_profile.hpp> for format
+  for (base::StringPiece line
+         : base::SplitStringPiece(contents, "\n"
+             , base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+  {
+    if (line.starts_with("#")) {
+      continue;
+    }
+    const std::vector<base::StringPiece> parts
+      = base::SplitStringPiece(line, "\t"
+          , base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+    uint64_t count = 0;
+    if (parts.size() != 3
+        || !base::StringToUint64(parts[2], &count))
+    {
+      LOG(WARNING)
+        << "make_reflect: malformed line in profile data "
+        << path
+        << ": "
+        << line;
+      continue;
+    }
+    profile[parts[0].as_string()][parts[1].as_string()] += count;
+  }
+
+  return profile;
+}
+
 clang_utils::SourceTransformResult
   MetaTooling::make_reflect(
     const clang_utils::SourceTransformOptions& sourceTransformOptions)
@@ -137,114 +783,790 @@ clang_utils::SourceTransformResult
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   VLOG(9)
-    << "make_removefuncbody called...";
+    << "make_reflect called...";
+
+  // used annotation attribute
+  // must point to
+  // __attribute__((annotate("{gen};{funccall};make_reflect;...")))
+  clang::CXXRecordDecl const *record =
+      getRecordToTransform(sourceTransformOptions);
+
+  if (!record) {
+    return clang_utils::SourceTransformResult{nullptr};
+  }
+
+  VLOG(9)
+    << "record name is "
+    << record->getNameAsString().c_str();
+
+  const bool profileFields
+    = getAnnotationArg(sourceTransformOptions, kProfileFieldsArg) == "true";
+  const std::string profileDataPath
+    = getAnnotationArg(sourceTransformOptions, kProfileDataArg);
+
+  // i.e. make_reflect(order = "declaration")
+  const std::string orderArg
+    = getAnnotationArg(sourceTransformOptions, kOrderArg);
+  const bool sortByName = orderArg.empty() || orderArg == kOrderSorted;
+  LOG_IF(WARNING, !sortByName && orderArg != kOrderDeclaration)
+    << "make_reflect: unknown order "
+    << orderArg
+    << ", expected "
+    << kOrderSorted
+    << " or "
+    << kOrderDeclaration;
+
+  DCHECK(sourceTransformOptions.matchResult.Context);
+  const clang::ASTContext& context
+    = *sourceTransformOptions.matchResult.Context;
+
+  ReflectEntries fields;
+  ReflectEntries methods;
+
+  // reflectable fields in declaration order
+  std::vector<std::string> fieldNames;
+
+  // reflectable fields that can be returned by reference
+  std::vector<std::string> profiledFieldNames;
+
+  // see https://github.com/Papierkorb/bindgen/blob/b55578e517a308778f5a510de02af499b353f15d/clang/src/record_match_handler.cpp
+  for (clang::Decl *decl : record->decls()) {
+    if (clang::CXXMethodDecl *method
+          = llvm::dyn_cast<clang::CXXMethodDecl>(decl)) {
+      //runOnMethod(method, isSignal);
+      DLOG(INFO) << "reflect is CXXMethodDecl " <<
+        method->getNameInfo().getName().getAsString().c_str() << " " <<
+        method->getReturnType().getAsString().c_str() << " " <<
+        method->getType().getUnqualifiedType().getAsString().c_str() << " " <<
+        method->getNameAsString().c_str();
+      if(isReflectable(method)) {
+        methods.set(method->getNameInfo().getName().getAsString()
+          , getNormalizedTypeName(method->getReturnType(), context));
+      }
+    } else if (clang::AccessSpecDecl *spec
+                  = llvm::dyn_cast<clang::AccessSpecDecl>(decl)) {
+      //isSignal = AccessSpecDecl(spec);
+      VLOG(9)
+        << "is CXXMethodDecl"
+        << dumpAccessSpecifier(spec->getAccess()).c_str();
+    } else if (clang::FieldDecl *field
+                  = llvm::dyn_cast<clang::FieldDecl>(decl)) {
+      VLOG(9)
+        << "field type is"
+        << field->getType().getUnqualifiedType().getAsString().c_str()
+        << " and field name is "
+        << field->getNameAsString().c_str();
+      if(isReflectable(field)) {
+        fields.set(field->getNameAsString()
+          , getNormalizedTypeName(field->getType(), context));
+        fieldNames.push_back(field->getNameAsString());
+        if (!field->isBitField()) {
+          profiledFieldNames.push_back(field->getNameAsString());
+        } else if (profileFields) {
+          LOG(WARNING)
+            << "make_reflect: profile_fields skips bit-field "
+            << record->getNameAsString()
+            << "::"
+            << field->getNameAsString()
+            << " that can not be bound to reference";
+        }
+      }
+    }
+  }
+
+  if (sortByName) {
+    fields.sortByName();
+    methods.sortByName();
+  }
 
   std::string indent = "  ";
-  std::string output{};
+  std::string body{};
 
   /// \note For simplisity we didn't use template engine.
   /// You can integrate with any template engine
   /// to avoid code like `output.append("\n");`
-  output.append("\n");
-  output.append(indent
-                  + "public:");
+  body.append(indent
+                + "public:");
   indent.append("  ");
+  body.append("\n");
+
+  appendReflectMap(body, indent, "fields", fields);
+  body.append("\n");
+  appendReflectMap(body, indent, "methods", methods);
+
+  if (profileFields && !profiledFieldNames.empty()) {
+    body.append("\n");
+    appendProfiledAccessors(body, indent
+      , record->getNameAsString()
+      , record->getQualifiedNameAsString()
+      , profiledFieldNames);
+  }
+
+  if (!profileDataPath.empty()) {
+    const FieldAccessProfile& profile = loadFieldProfile(profileDataPath);
+    auto it = profile.find(record->getQualifiedNameAsString());
+    if (it == profile.end()) {
+      LOG(WARNING)
+        << "make_reflect: no profile data for "
+        << record->getQualifiedNameAsString()
+        << " in "
+        << profileDataPath;
+    } else {
+      body.append("\n");
+      appendHotColdFields(body, indent
+        , record->getQualifiedNameAsString()
+        , fieldNames, it->second);
+    }
+  }
+
+  // output depends only on declarations in record,
+  // so unchanged input produces byte-identical output
+  std::string output{};
+  output.append("\n");
+  output.append("  // flex_meta content hash: "
+                  + base::StringPrintf("%016" PRIx64, fnv1a64(body)));
   output.append("\n");
+  output.append(body);
+
+  auto locEnd = record->getLocEnd();
+
+  // add new field with reflection data at the end of the C++ record
+  sourceTransformOptions.rewriter.InsertText(locEnd, output,
+    /*InsertAfter=*/true, /*IndentNewLines*/ false);
+
+  return clang_utils::SourceTransformResult{nullptr};
+}
+
+clang_utils::SourceTransformResult
+  MetaTooling::make_columnar(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  auto appendMembers = [&](const clang::CXXRecordDecl* record
+                           , const std::string& recordName
+                           , const std::string& indent
+                           , std::string& output)
+  {
+    struct Column {
+      std::string name;
+      ColumnKind kind;
+      bool dictionary;
+    };
+
+    std::vector<Column> columns;
+    for (const clang::FieldDecl* field : record->fields()) {
+      if (!isReflectable(field)) {
+        continue;
+      }
+      const ColumnKind kind = getColumnKind(field->getType());
+      if (kind == ColumnKind::kUnsupported) {
+        LOG(WARNING)
+          << "make_columnar skipped field "
+          << recordName
+          << "::"
+          << field->getNameAsString()
+          << " with unsupported type "
+          << field->getType().getAsString();
+        continue;
+      }
+      columns.push_back(Column{
+        field->getNameAsString()
+        , kind
+        , kind == ColumnKind::kString
+          && hasGenAttrFlag(field, kAttrDictionaryFlag)});
+    }
+
+    const std::string kWriterType
+      = "::flex_meta::columnar::BatchWriter";
+
+    /// \note Generated code requires <flex_meta_plugin/columnar.hpp>
 
-  std::map<std::string, std::string> fields;
-  std::map<std::string, std::string> methods;
+    // declares columns in order of reflectable fields,
+    // so column index in file == index of field in `columns`
+    output.append(indent
+                    + "static void columnar_schema("
+                    + kWriterType + "& writer)");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    for (const Column& column : columns) {
+      if (column.kind == ColumnKind::kNumeric) {
+        output.append(indent + indent
+                        + "writer.addNumericColumn<"
+                          "::flex_meta::columnar::column_value_t<decltype("
+                        + recordName + "::" + column.name + ")>>(");
+        output.append("\"" + column.name + "\");");
+      } else {
+        output.append(indent + indent
+                        + "writer.addStringColumn(");
+        output.append("\"" + column.name + "\"");
+        output.append(column.dictionary
+                        ? ", /*dictionary*/ true);"
+                        : ", /*dictionary*/ false);");
+      }
+      output.append("\n");
+    }
+    output.append(indent + "}");
+    output.append("\n");
+
+    // writes each field into its own contiguous column buffer,
+    // at most one row group at a time, so large batches
+    // are streamed to disk instead of being buffered in memory
+    const std::string body = indent + indent + indent;
+    output.append("\n");
+    output.append(indent
+                    + "static void columnar_append(const "
+                    + recordName + "* records, std::size_t count, "
+                    + kWriterType + "& writer)");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    output.append(indent + indent
+                    + "while (count != 0) {");
+    output.append("\n");
+    output.append(body
+                    + "const std::size_t rows = count < writer.rowsUntilFlush()");
+    output.append("\n");
+    output.append(body + indent
+                    + "? count : writer.rowsUntilFlush();");
+    output.append("\n");
+    for (size_t index = 0; index < columns.size(); ++index) {
+      const Column& column = columns[index];
+      const std::string columnIndex = std::to_string(index);
+      if (column.kind == ColumnKind::kNumeric) {
+        const std::string valueType
+          = "::flex_meta::columnar::column_value_t<decltype("
+            + recordName + "::" + column.name + ")>";
+        output.append(body + "{");
+        output.append("\n");
+        output.append(body + indent
+                        + "auto* column = writer.appendNumeric<"
+                        + valueType + ">(" + columnIndex + ", rows);");
+        output.append("\n");
+        output.append(body + indent
+                        + "for (std::size_t i = 0; i < rows; ++i) {");
+        output.append("\n");
+        output.append(body + indent + indent
+                        + "column[i] = static_cast<" + valueType
+                        + ">(records[i]." + column.name + ");");
+        output.append("\n");
+        output.append(body + indent + "}");
+        output.append("\n");
+        output.append(body + "}");
+      } else {
+        output.append(body
+                        + "writer.reserveStrings("
+                        + columnIndex + ", rows);");
+        output.append("\n");
+        output.append(body
+                        + "for (std::size_t i = 0; i < rows; ++i) {");
+        output.append("\n");
+        output.append(body + indent
+                        + "writer.appendString(" + columnIndex
+                        + ", records[i]." + column.name + ");");
+        output.append("\n");
+        output.append(body + "}");
+      }
+      output.append("\n");
+    }
+    output.append(body
+                    + "writer.commitRows(rows);");
+    output.append("\n");
+    output.append(body
+                    + "records += rows;");
+    output.append("\n");
+    output.append(body
+                    + "count -= rows;");
+    output.append("\n");
+    output.append(indent + indent + "}");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    output.append("\n");
+    appendRangeOverload(output, indent
+      , "void", "columnar_append"
+      , kWriterType + "& writer", "writer");
+
+    return true;
+  };
 
   // used annotation attribute
   // must point to
-  // __attribute__((annotate("{gen};{funccall};make_reflect;...")))
-  clang::CXXRecordDecl const *record =
-      sourceTransformOptions.matchResult.Nodes
-      .getNodeAs<clang::CXXRecordDecl>("bind_gen");
+  // __attribute__((annotate("{gen};{funccall};make_columnar;...")))
+  return transformRecord("make_columnar", sourceTransformOptions, appendMembers);
+}
 
-  if (record) {
-    VLOG(9)
-      << "record name is "
-      << record->getNameAsString().c_str();
-
-    // see https://github.com/Papierkorb/bindgen/blob/b55578e517a308778f5a510de02af499b353f15d/clang/src/record_match_handler.cpp
-    for (clang::Decl *decl : record->decls()) {
-      if (clang::CXXMethodDecl *method
-            = llvm::dyn_cast<clang::CXXMethodDecl>(decl)) {
-        //runOnMethod(method, isSignal);
-        DLOG(INFO) << "reflect is CXXMethodDecl " <<
-          method->getNameInfo().getName().getAsString().c_str() << " " <<
-          method->getReturnType().getAsString().c_str() << " " <<
-          method->getType().getUnqualifiedType().getAsString().c_str() << " " <<
-          method->getNameAsString().c_str();
-        if(isReflectable(method)) {
-          methods[method->getNameInfo().getName().getAsString()] =
-            method->getReturnType().getAsString().c_str();
+clang_utils::SourceTransformResult
+  MetaTooling::make_pool(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  auto appendMembers = [&](const clang::CXXRecordDecl* record
+                           , const std::string& recordName
+                           , const std::string& indent
+                           , std::string& output)
+  {
+    const bool withReset
+      = getAnnotationArg(sourceTransformOptions, kPoolResetArg) == "true";
+
+    // reflectable fields that can be assigned in place
+    std::vector<std::string> resetFields;
+    if (withReset) {
+      for (const clang::FieldDecl* field : record->fields()) {
+        if (!isReflectable(field)) {
+          continue;
         }
-      } else if (clang::AccessSpecDecl *spec
-                    = llvm::dyn_cast<clang::AccessSpecDecl>(decl)) {
-        //isSignal = AccessSpecDecl(spec);
-        VLOG(9)
-          << "is CXXMethodDecl"
-          << dumpAccessSpecifier(spec->getAccess()).c_str();
-      } else if (clang::FieldDecl *field
-                    = llvm::dyn_cast<clang::FieldDecl>(decl)) {
-        VLOG(9)
-          << "field type is"
-          << field->getType().getUnqualifiedType().getAsString().c_str()
-          << " and field name is "
-          << field->getNameAsString().c_str();
-        if(isReflectable(field)) {
-          fields[field->getNameAsString()] =
-            field->getType().getUnqualifiedType().getAsString().c_str();
+        const clang::QualType type = field->getType();
+        if (type->isReferenceType()
+            || type.isConstQualified()
+            || field->isBitField())
+        {
+          LOG(WARNING)
+            << "make_pool: pool_reset skips field "
+            << recordName
+            << "::"
+            << field->getNameAsString()
+            << " that can not be value-initialized in place";
+          continue;
         }
+        resetFields.push_back(field->getNameAsString());
       }
     }
 
-    // TODO: use template
+    const std::string kPoolType
+      = "::flex_meta::pool::ObjectPool<" + recordName + ">";
+
+    /// \note Generated code requires <flex_meta_plugin/object_pool.hpp>
 
     output.append(indent
-                    + "static std::map<std::string, std::string> fields");
-    output.append(" = {");
+                    + "static " + kPoolType + "& pool()");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    output.append(indent + indent
+                    + "return " + kPoolType + "::instance();");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    output.append("\n");
+    output.append(indent
+                    + "template<typename... Args>");
     output.append("\n");
-    for(const auto& [key, value] : fields) {
+    output.append(indent
+                    + "static " + recordName + "* pool_create(Args&&... args)");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    output.append(indent + indent
+                    + "return pool().create(std::forward<Args>(args)...);");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    output.append("\n");
+    output.append(indent
+                    + "static void pool_destroy(" + recordName + "* object)");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    output.append(indent + indent
+                    + "pool().destroy(object);");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    if (withReset) {
+      // allows to reuse object without destroy + create
+      output.append("\n");
       output.append(indent
-                      + indent + "{ ");
-      output.append("\"" + key + "\"");
-      output.append(", ");
-      output.append("\"" + value + "\"");
-      output.append(" }");
+                      + "void pool_reset()");
+      output.append("\n");
+      output.append(indent + "{");
+      output.append("\n");
+      for (const std::string& field : resetFields) {
+        output.append(indent + indent
+                        + "::flex_meta::pool::resetValue(" + field + ");");
+        output.append("\n");
+      }
+      output.append(indent + "}");
+      output.append("\n");
+    }
+
+    return true;
+  };
+
+  // used annotation attribute
+  // must point to
+  // __attribute__((annotate("{gen};{funccall};make_pool;...")))
+  return transformRecord("make_pool", sourceTransformOptions, appendMembers);
+}
+
+clang_utils::SourceTransformResult
+  MetaTooling::make_validate(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  auto appendMembers = [&](const clang::CXXRecordDecl* record
+                           , const std::string& recordName
+                           , const std::string& indent
+                           , std::string& output)
+  {
+    DCHECK(sourceTransformOptions.matchResult.Context);
+    const clang::ASTContext& context
+      = *sourceTransformOptions.matchResult.Context;
+
+    struct Constraint {
+      std::string field;
+      RangeLiterals bounds;
+    };
+
+    std::vector<Constraint> constraints;
+    for (const clang::FieldDecl* field : record->fields()) {
+      if (!isReflectable(field)) {
+        continue;
+      }
+      RangeConstraint range;
+      if (!getRangeConstraint(field, &range)) {
+        continue;
+      }
+      RangeLiterals bounds;
+      if (!getRangeLiterals(range, field->getType(), context, &bounds)) {
+        LOG(WARNING)
+          << "make_validate skipped range("
+          << range.min
+          << ","
+          << range.max
+          << ") of field "
+          << recordName
+          << "::"
+          << field->getNameAsString()
+          << ", bounds are not representable in field type "
+          << field->getType().getAsString();
+        continue;
+      }
+      if (bounds.min.empty() && bounds.max.empty()) {
+        VLOG(9)
+          << "make_validate: range of field "
+          << recordName
+          << "::"
+          << field->getNameAsString()
+          << " covers whole field type";
+        continue;
+      }
+      constraints.push_back(Constraint{field->getNameAsString(), bounds});
+    }
+
+    /// \note Bounds are representable in field type (see |getRangeLiterals|),
+    /// comparisons are combined with `&` (not `&&`)
+    /// so checks have no branches.
+
+    output.append(indent
+                    + "bool validate() const");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    output.append(indent + indent
+                    + "bool valid = true;");
+    output.append("\n");
+    for (const Constraint& constraint : constraints) {
+      const std::string valueType
+        = "std::remove_cv_t<decltype(" + recordName
+          + "::" + constraint.field + ")>";
+      std::vector<std::string> checks;
+      if (!constraint.bounds.min.empty()) {
+        checks.push_back("(" + constraint.field
+          + " >= static_cast<" + valueType + ">("
+          + constraint.bounds.min + "))");
+      }
+      if (!constraint.bounds.max.empty()) {
+        checks.push_back("(" + constraint.field
+          + " <= static_cast<" + valueType + ">("
+          + constraint.bounds.max + "))");
+      }
+      output.append(indent + indent
+                      + "valid &= " + checks.front());
+      for (size_t i = 1; i < checks.size(); ++i) {
+        output.append("\n");
+        output.append(indent + indent + indent
+                        + "& " + checks[i]);
+      }
+      output.append(";");
       output.append("\n");
     }
+    output.append(indent + indent
+                    + "return valid;");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    // checks one field of all records per loop,
+    // so each loop can be vectorized by compiler
     output.append("\n");
     output.append(indent
-                  + "};");
+                    + "// sets valid[i] to 1 if records[i] is valid, else to 0");
     output.append("\n");
-    // methods
+    output.append(indent
+                    + "// returns number of valid records");
     output.append("\n");
     output.append(indent
-                    + "static std::map<std::string, std::string> methods");
-    output.append(" = {");
+                    + "static std::size_t validate_batch(const "
+                    + recordName + "* records, std::size_t count, "
+                      "unsigned char* valid)");
+    output.append("\n");
+    output.append(indent + "{");
     output.append("\n");
-    for(const auto& [key, value] : methods) {
+    output.append(indent + indent
+                    + "for (std::size_t i = 0; i < count; ++i) {");
+    output.append("\n");
+    output.append(indent + indent + indent
+                    + "valid[i] = 1;");
+    output.append("\n");
+    output.append(indent + indent + "}");
+    output.append("\n");
+    for (const Constraint& constraint : constraints) {
+      const std::string valueType
+        = "std::remove_cv_t<decltype(" + recordName
+          + "::" + constraint.field + ")>";
+      std::vector<std::string> checks;
+      output.append(indent + indent + "{");
+      output.append("\n");
+      if (!constraint.bounds.min.empty()) {
+        output.append(indent + indent + indent
+                        + "const " + valueType + " min = static_cast<"
+                        + valueType + ">(" + constraint.bounds.min + ");");
+        output.append("\n");
+        checks.push_back("(value >= min)");
+      }
+      if (!constraint.bounds.max.empty()) {
+        output.append(indent + indent + indent
+                        + "const " + valueType + " max = static_cast<"
+                        + valueType + ">(" + constraint.bounds.max + ");");
+        output.append("\n");
+        checks.push_back("(value <= max)");
+      }
+      output.append(indent + indent + indent
+                      + "for (std::size_t i = 0; i < count; ++i) {");
+      output.append("\n");
+      output.append(indent + indent + indent + indent
+                      + "const " + valueType + " value = records[i]."
+                      + constraint.field + ";");
+      output.append("\n");
+      output.append(indent + indent + indent + indent
+                      + "valid[i] &= static_cast<unsigned char>("
+                      + base::JoinString(checks, " & ") + ");");
+      output.append("\n");
+      output.append(indent + indent + indent + "}");
+      output.append("\n");
+      output.append(indent + indent + "}");
+      output.append("\n");
+    }
+    output.append(indent + indent
+                    + "std::size_t validCount = 0;");
+    output.append("\n");
+    output.append(indent + indent
+                    + "for (std::size_t i = 0; i < count; ++i) {");
+    output.append("\n");
+    output.append(indent + indent + indent
+                    + "validCount += valid[i];");
+    output.append("\n");
+    output.append(indent + indent + "}");
+    output.append("\n");
+    output.append(indent + indent
+                    + "return validCount;");
+    output.append("\n");
+    output.append(indent + "}");
+    output.append("\n");
+
+    output.append("\n");
+    appendRangeOverload(output, indent
+      , "std::size_t", "validate_batch"
+      , "unsigned char* valid", "valid");
+
+    return true;
+  };
+
+  // used annotation attribute
+  // must point to
+  // __attribute__((annotate("{gen};{funccall};make_validate;...")))
+  return transformRecord("make_validate", sourceTransformOptions, appendMembers);
+}
+
+clang_utils::SourceTransformResult
+  MetaTooling::make_dynamic(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  auto appendMembers = [&](const clang::CXXRecordDecl* record
+                           , const std::string& recordName
+                           , const std::string& indent
+                           , std::string& output)
+  {
+    // reflectable fields that can be accessed via pointer to member
+    std::vector<std::string> fieldNames;
+    for (const clang::FieldDecl* field : record->fields()) {
+      if (!isReflectable(field)) {
+        continue;
+      }
+      if (field->getType()->isReferenceType()
+          || field->isBitField())
+      {
+        LOG(WARNING)
+          << "make_dynamic skipped field "
+          << recordName
+          << "::"
+          << field->getNameAsString()
+          << " without pointer to member (reference or bit-field)";
+        continue;
+      }
+      fieldNames.push_back(field->getNameAsString());
+    }
+
+    // table is searched by name
+    std::sort(fieldNames.begin(), fieldNames.end());
+
+    // offsetof is conditionally-supported for other records
+    const bool hasOffsets = record->isStandardLayout();
+
+    const std::string kDynamicNamespace = "::flex_meta::dynamic::";
+
+    /// \note Generated code requires <flex_meta_plugin/dynamic_access.hpp>
+    /// Table is defined in member function,
+    /// because record is not complete in static member initializers.
+
+    output.append(indent
+                    + "static " + kDynamicNamespace + "FieldTable dynamic_fields()");
+    output.append("\n");
+    output.append(indent + "{");
+    output.append("\n");
+    if (fieldNames.empty()) {
       output.append(indent + indent
-                      + "{ ");
-      output.append("\"" + key + "\"");
-      output.append(", ");
-      output.append("\"" + value + "\"");
-      output.append(" }");
+                      + "return " + kDynamicNamespace + "FieldTable{nullptr, 0};");
+      output.append("\n");
+    } else {
+      output.append(indent + indent
+                      + "static constexpr " + kDynamicNamespace
+                      + "FieldEntry kFields[] = {");
+      output.append("\n");
+      for (const std::string& field : fieldNames) {
+        const std::string member = recordName + "::" + field;
+        const std::string memberArgs
+          = recordName + ", decltype(" + member + "), &" + member;
+        output.append(indent + indent + indent
+                        + "{\"" + field + "\"");
+        output.append("\n");
+        output.append(indent + indent + indent + indent
+                        + ", " + (hasOffsets
+                            ? "offsetof(" + recordName + ", " + field + ")"
+                            : kDynamicNamespace + "kNoOffset"));
+        output.append("\n");
+        output.append(indent + indent + indent + indent
+                        + ", " + kDynamicNamespace
+                        + "fieldTypeOf<decltype(" + member + ")>()");
+        output.append("\n");
+        output.append(indent + indent + indent + indent
+                        + ", &" + kDynamicNamespace
+                        + "readField<" + memberArgs + ">");
+        output.append("\n");
+        output.append(indent + indent + indent + indent
+                        + ", " + kDynamicNamespace
+                        + "fieldSetter<" + memberArgs + ">()},");
+        output.append("\n");
+      }
+      output.append(indent + indent + "};");
+      output.append("\n");
+      output.append(indent + indent
+                      + "return " + kDynamicNamespace
+                      + "FieldTable{kFields, std::size(kFields)};");
       output.append("\n");
     }
+    output.append(indent + "}");
     output.append("\n");
-    output.append(indent +
-                    "};");
+
+    return true;
+  };
+
+  // used annotation attribute
+  // must point to
+  // __attribute__((annotate("{gen};{funccall};make_dynamic;...")))
+  return transformRecord("make_dynamic", sourceTransformOptions, appendMembers);
+}
+
+clang_utils::SourceTransformResult
+  MetaTooling::make_registry(
+    const clang_utils::SourceTransformOptions& sourceTransformOptions)
+{
+  auto appendMembers = [&](const clang::CXXRecordDecl* record
+                           , const std::string& recordName
+                           , const std::string& indent
+                           , std::string& output)
+  {
+    // static data members are not allowed in local classes
+    // and are not emitted for templates until instantiated
+    // (including records nested in class templates)
+    if (record->isLocalClass()
+        || record->getDescribedClassTemplate()
+        || llvm::isa<clang::ClassTemplateSpecializationDecl>(record)
+        || record->isDependentContext())
+    {
+      LOG(WARNING)
+        << "make_registry does not support local classes and templates: "
+        << record->getQualifiedNameAsString();
+      return false;
+    }
+
+    // record from anonymous namespace has the same name and type id
+    // in every translation unit, so lookup by name is ambiguous
+    if (record->isInAnonymousNamespace()) {
+      LOG(WARNING)
+        << "make_registry does not support records"
+           " in anonymous namespaces: "
+        << record->getQualifiedNameAsString();
+      return false;
+    }
+
+    const std::string qualifiedName = record->getQualifiedNameAsString();
+
+    // must match ::flex_meta::registry::typeIdOf
+    const uint64_t typeId = fnv1a64(qualifiedName);
+
+    const std::string kRegistryNamespace = "::flex_meta::registry::";
+
+    /// \note Generated code requires <flex_meta_plugin/registry.hpp>
+    /// Pointer to entry (not entry itself) is placed into linker section,
+    /// because compiler may over-align large objects
+    /// and section must be array without gaps.
+
+    output.append(indent
+                    + "static constexpr " + kRegistryNamespace
+                    + "RecordEntry flex_meta_registry_entry = {");
+    output.append("\n");
+    output.append(indent + indent
+                    + "\"" + qualifiedName + "\"");
+    output.append("\n");
+    output.append(indent + indent
+                    + ", " + base::StringPrintf("0x%016" PRIx64 "ULL", typeId));
+    output.append("\n");
+    output.append(indent + indent
+                    + ", &" + kRegistryNamespace
+                    + "fieldsOf<" + recordName + ">};");
     output.append("\n");
-    auto locEnd = record->getLocEnd();
 
-    // add new field with reflection data at the end of the C++ record
-    sourceTransformOptions.rewriter.InsertText(locEnd, output,
-      /*InsertAfter=*/true, /*IndentNewLines*/ false);
-  }
-  return clang_utils::SourceTransformResult{nullptr};
+    output.append(indent
+                    + "FLEX_META_REGISTRY_SECTION");
+    output.append("\n");
+    output.append(indent
+                    + "inline static const " + kRegistryNamespace
+                    + "RecordEntry* flex_meta_registry_ref");
+    output.append("\n");
+    output.append(indent + indent
+                    + "= &flex_meta_registry_entry;");
+    output.append("\n");
+
+    return true;
+  };
+
+  // used annotation attribute
+  // must point to
+  // __attribute__((annotate("{gen};{funccall};make_registry;...")))
+  return transformRecord("make_registry", sourceTransformOptions, appendMembers);
 }
 
 } // namespace plugin
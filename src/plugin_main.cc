@@ -26,6 +26,7 @@
 #include <base/debug/stack_trace.h>
 #include <base/memory/ptr_util.h>
 #include <base/sequenced_task_runner.h>
+#include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
 #include <base/trace_event/trace_event.h>
 
@@ -83,6 +84,16 @@ class FlexMeta
       << description().substr(0, 100)
       << "...";
 
+    // see [configuration] in flex_meta_plugin.conf
+    eventHandler_.SetSkipSystemHeaders(
+      configuration().value("skip_system_headers") == "true");
+    eventHandler_.SetSkipPathPatterns(
+      base::SplitString(
+        configuration().value("skip_path_patterns")
+        , ";"
+        , base::TRIM_WHITESPACE
+        , base::SPLIT_WANT_NONEMPTY));
+
     return true;
   }
 
@@ -0,0 +1,155 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <flex_meta_plugin/columnar.hpp>
+
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+enum class Color : uint8_t { kRed, kGreen };
+
+} // namespace
+
+TEST(columnarTest, RoundTripThroughMappedFile) {
+  base::ScopedTempDir tempDir;
+  ASSERT_TRUE(tempDir.CreateUniqueTempDir());
+  const std::string path
+    = tempDir.GetPath().AppendASCII("records.fmcol").value();
+
+  using namespace ::flex_meta::columnar;
+
+  static_assert(std::is_same<column_value_t<const Color>, uint8_t>::value
+    , "enums must be stored as underlying type");
+
+  {
+    // small row group forces several row groups in file
+    BatchWriter writer(/*rowGroupSize*/ 3);
+    const size_t idColumn = writer.addNumericColumn<int64_t>("id");
+    const size_t colorColumn
+      = writer.addNumericColumn<column_value_t<Color>>("color");
+    const size_t cityColumn = writer.addStringColumn("city", true);
+    const size_t nameColumn = writer.addStringColumn("name", false);
+    ASSERT_TRUE(writer.open(path));
+    for (int64_t i = 0; i < 10; ++i) {
+      *writer.appendNumeric<int64_t>(idColumn, 1) = i;
+      *writer.appendNumeric<uint8_t>(colorColumn, 1)
+        = static_cast<uint8_t>(i % 2 ? Color::kGreen : Color::kRed);
+      writer.appendString(cityColumn, i % 2 ? "Oslo" : "Rome");
+      writer.appendString(nameColumn, "name" + std::to_string(i));
+      ASSERT_TRUE(writer.commitRows(1));
+    }
+    EXPECT_EQ(writer.totalRows(), 10u);
+    ASSERT_TRUE(writer.close());
+  }
+
+  MappedReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.totalRows(), 10u);
+  ASSERT_EQ(reader.columns().size(), 4u);
+  EXPECT_EQ(reader.columns()[0].name, "id");
+  EXPECT_EQ(reader.columns()[0].type, ColumnType::kInt64);
+  EXPECT_EQ(reader.columns()[2].type, ColumnType::kDictString);
+  EXPECT_EQ(reader.columns()[3].type, ColumnType::kString);
+  EXPECT_EQ(reader.rowGroups().size(), 4u);
+
+  int64_t row = 0;
+  for (const MappedReader::RowGroup& group : reader.rowGroups()) {
+    for (uint64_t i = 0; i < group.rowCount(); ++i, ++row) {
+      EXPECT_EQ(group.numeric<int64_t>(0)[i], row);
+      EXPECT_EQ(group.numeric<uint8_t>(1)[i], row % 2);
+      EXPECT_EQ(group.string(2, i), row % 2 ? "Oslo" : "Rome");
+      EXPECT_EQ(group.string(3, i), "name" + std::to_string(row));
+    }
+  }
+  EXPECT_EQ(row, 10);
+}
+
+TEST(columnarTest, RejectsTruncatedFile) {
+  base::ScopedTempDir tempDir;
+  ASSERT_TRUE(tempDir.CreateUniqueTempDir());
+  const base::FilePath path
+    = tempDir.GetPath().AppendASCII("truncated.fmcol");
+
+  {
+    ::flex_meta::columnar::BatchWriter writer;
+    writer.addNumericColumn<int32_t>("value");
+    ASSERT_TRUE(writer.open(path.value()));
+    *writer.appendNumeric<int32_t>(0, 1) = 42;
+    ASSERT_TRUE(writer.commitRows(1));
+    ASSERT_TRUE(writer.close());
+  }
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  // drop footer (magic + row group count + total row count)
+  contents.resize(contents.size() - 24);
+  ASSERT_EQ(base::WriteFile(path, contents.data(), contents.size())
+    , static_cast<int>(contents.size()));
+
+  ::flex_meta::columnar::MappedReader reader;
+  EXPECT_FALSE(reader.open(path.value()));
+}
+
+TEST(columnarTest, RejectsCorruptedStringChunks) {
+  base::ScopedTempDir tempDir;
+  ASSERT_TRUE(tempDir.CreateUniqueTempDir());
+
+  using namespace ::flex_meta::columnar;
+
+  for (const bool dictionary : {false, true}) {
+    const base::FilePath path = tempDir.GetPath().AppendASCII(
+      dictionary ? "dictionary.fmcol" : "string.fmcol");
+    {
+      BatchWriter writer;
+      writer.addStringColumn("name", dictionary);
+      ASSERT_TRUE(writer.open(path.value()));
+      writer.appendString(0, "value");
+      ASSERT_TRUE(writer.commitRows(1));
+      ASSERT_TRUE(writer.close());
+    }
+
+    std::string contents;
+    ASSERT_TRUE(base::ReadFileToString(path, &contents));
+    const size_t group = contents.find(
+      std::string(kRowGroupMagic, sizeof(kRowGroupMagic)));
+    ASSERT_NE(group, std::string::npos);
+    // magic + row count + group size + chunk size
+    const size_t chunk = group + 4 * sizeof(uint64_t);
+    if (dictionary) {
+      // index of first row
+      const uint32_t index = 1;
+      contents.replace(chunk, sizeof(index)
+        , reinterpret_cast<const char*>(&index), sizeof(index));
+    } else {
+      // end offset of first row
+      const uint64_t offset = 1 << 20;
+      contents.replace(chunk + sizeof(uint64_t), sizeof(offset)
+        , reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    ASSERT_EQ(base::WriteFile(path, contents.data(), contents.size())
+      , static_cast<int>(contents.size()));
+
+    MappedReader reader;
+    EXPECT_FALSE(reader.open(path.value())) << path.value();
+  }
+}
+
+TEST(columnarTest, LimitsBatchToRowGroup) {
+  ::flex_meta::columnar::BatchWriter writer(/*rowGroupSize*/ 4);
+  writer.addNumericColumn<int32_t>("value");
+  EXPECT_EQ(writer.rowsUntilFlush(), 4u);
+  writer.appendNumeric<int32_t>(0, 3);
+  ASSERT_TRUE(writer.commitRows(3));
+  EXPECT_EQ(writer.rowsUntilFlush(), 1u);
+}
@@ -0,0 +1,136 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <flex_meta_plugin/dynamic_access.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace {
+
+// same members as generated by `make_dynamic`
+class Person {
+public:
+  explicit Person(int id)
+    : id(id)
+  {}
+
+  static ::flex_meta::dynamic::FieldTable dynamic_fields()
+  {
+    static constexpr ::flex_meta::dynamic::FieldEntry kFields[] = {
+      {"age"
+        , offsetof(Person, age)
+        , ::flex_meta::dynamic::fieldTypeOf<decltype(Person::age)>()
+        , &::flex_meta::dynamic::readField<
+            Person, decltype(Person::age), &Person::age>
+        , ::flex_meta::dynamic::fieldSetter<
+            Person, decltype(Person::age), &Person::age>()},
+      {"id"
+        , offsetof(Person, id)
+        , ::flex_meta::dynamic::fieldTypeOf<decltype(Person::id)>()
+        , &::flex_meta::dynamic::readField<
+            Person, decltype(Person::id), &Person::id>
+        , ::flex_meta::dynamic::fieldSetter<
+            Person, decltype(Person::id), &Person::id>()},
+      {"name"
+        , offsetof(Person, name)
+        , ::flex_meta::dynamic::fieldTypeOf<decltype(Person::name)>()
+        , &::flex_meta::dynamic::readField<
+            Person, decltype(Person::name), &Person::name>
+        , ::flex_meta::dynamic::fieldSetter<
+            Person, decltype(Person::name), &Person::name>()},
+      {"scores"
+        , offsetof(Person, scores)
+        , ::flex_meta::dynamic::fieldTypeOf<decltype(Person::scores)>()
+        , &::flex_meta::dynamic::readField<
+            Person, decltype(Person::scores), &Person::scores>
+        , ::flex_meta::dynamic::fieldSetter<
+            Person, decltype(Person::scores), &Person::scores>()},
+    };
+    return ::flex_meta::dynamic::FieldTable{kFields, std::size(kFields)};
+  }
+
+  int getAge() const { return age; }
+
+private:
+  std::string name;
+
+  int age = 0;
+
+  const int id;
+
+  double scores[2] = {};
+};
+
+} // namespace
+
+TEST(dynamicAccessTest, GetsAndSetsFieldsByName) {
+  using ::flex_meta::dynamic::get;
+  using ::flex_meta::dynamic::set;
+
+  Person person(7);
+  EXPECT_TRUE(set(person, "age", 42));
+  EXPECT_TRUE(set(person, "name", std::string("Alice")));
+  EXPECT_EQ(42, person.getAge());
+
+  ASSERT_NE(nullptr, get<int>(person, "age"));
+  EXPECT_EQ(42, *get<int>(person, "age"));
+  ASSERT_NE(nullptr, get<std::string>(person, "name"));
+  EXPECT_EQ("Alice", *get<std::string>(person, "name"));
+  ASSERT_NE(nullptr, get<int>(person, "id"));
+  EXPECT_EQ(7, *get<int>(person, "id"));
+}
+
+TEST(dynamicAccessTest, RejectsUnknownNamesAndTypes) {
+  using ::flex_meta::dynamic::get;
+  using ::flex_meta::dynamic::set;
+
+  Person person(7);
+  EXPECT_EQ(nullptr, get<int>(person, "missing"));
+  EXPECT_EQ(nullptr, get<int>(person, "ag"));
+  EXPECT_EQ(nullptr, get<double>(person, "age"));
+  EXPECT_FALSE(set(person, "age", 1.5));
+  EXPECT_FALSE(set(person, "missing", 1));
+  // const field
+  EXPECT_FALSE(set(person, "id", 8));
+  EXPECT_EQ(7, *get<int>(person, "id"));
+}
+
+TEST(dynamicAccessTest, ProvidesOffsetsAndUntypedAccess) {
+  const ::flex_meta::dynamic::FieldEntry* scores
+    = ::flex_meta::dynamic::findField(Person::dynamic_fields(), "scores");
+  ASSERT_NE(nullptr, scores);
+  EXPECT_EQ(::flex_meta::dynamic::FieldType::kOther, scores->type);
+  EXPECT_EQ(nullptr, scores->setter);
+
+  Person person(7);
+  const double* values
+    = static_cast<const double*>(scores->getter(&person));
+  EXPECT_EQ(reinterpret_cast<const char*>(&person) + scores->offset
+    , reinterpret_cast<const char*>(values));
+}
+
+TEST(dynamicAccessTest, TagsIntegersBySizeAndSignedness) {
+  using ::flex_meta::dynamic::FieldType;
+  using ::flex_meta::dynamic::fieldTypeOf;
+
+  EXPECT_EQ(FieldType::kChar, fieldTypeOf<char>());
+  EXPECT_EQ(FieldType::kBool, fieldTypeOf<const bool>());
+  EXPECT_EQ(FieldType::kInt8, fieldTypeOf<signed char>());
+  EXPECT_EQ(FieldType::kUInt8, fieldTypeOf<unsigned char>());
+  EXPECT_EQ(FieldType::kInt16, fieldTypeOf<short>());
+  EXPECT_EQ(FieldType::kInt32, fieldTypeOf<int>());
+  EXPECT_EQ(fieldTypeOf<int64_t>(), fieldTypeOf<long long>());
+  EXPECT_EQ(fieldTypeOf<uint64_t>(), fieldTypeOf<unsigned long long>());
+  EXPECT_EQ(FieldType::kInt64, fieldTypeOf<long long>());
+  EXPECT_EQ(sizeof(long) == 8 ? FieldType::kUInt64 : FieldType::kUInt32
+    , fieldTypeOf<unsigned long>());
+  EXPECT_EQ(FieldType::kOther, fieldTypeOf<char32_t>());
+}
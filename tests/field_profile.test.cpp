@@ -0,0 +1,101 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <flex_meta_plugin/field_profile.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// same members as generated by `make_reflect(profile_fields = "true")`
+struct ProfiledRecord {
+  static constexpr const char* flex_meta_profile_record
+    = "ProfiledRecord";
+  static constexpr const char* flex_meta_profile_fields[] = {
+    "hot",
+    "cold"
+  };
+};
+
+uint64_t countOf(const std::vector<::flex_meta::profile::FieldCount>& counts
+  , const std::string& field)
+{
+  auto it = std::find_if(counts.begin(), counts.end()
+    , [&field](const ::flex_meta::profile::FieldCount& it) {
+        return it.record == "ProfiledRecord" && it.field == field;
+      });
+  return it == counts.end() ? 0 : it->count;
+}
+
+} // namespace
+
+TEST(fieldProfileTest, SumsCountersOfAllThreads) {
+  using ::flex_meta::profile::FieldProfile;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; ++j) {
+        FieldProfile<ProfiledRecord>::hit(0);
+      }
+      FieldProfile<ProfiledRecord>::hit(1);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // counters of finished threads are kept
+  const std::vector<::flex_meta::profile::FieldCount> counts
+    = ::flex_meta::profile::Registry::instance().collect();
+  EXPECT_EQ(countOf(counts, "hot"), 4000u);
+  EXPECT_EQ(countOf(counts, "cold"), 4u);
+}
+
+namespace {
+
+struct ShortLivedRecord {
+  static constexpr const char* flex_meta_profile_record
+    = "ShortLivedRecord";
+  static constexpr const char* flex_meta_profile_fields[] = {
+    "value"
+  };
+};
+
+} // namespace
+
+TEST(fieldProfileTest, FreesShardsOfExitedThreads) {
+  using ::flex_meta::profile::FieldProfile;
+  using ::flex_meta::profile::Registry;
+
+  for (int round = 0; round < 50; ++round) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([]() {
+        for (int j = 0; j < 10; ++j) {
+          FieldProfile<ShortLivedRecord>::hit(0);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(Registry::instance().shardCount("ShortLivedRecord"), 0u);
+  }
+
+  const std::vector<::flex_meta::profile::FieldCount> counts
+    = Registry::instance().collect();
+  auto it = std::find_if(counts.begin(), counts.end()
+    , [](const ::flex_meta::profile::FieldCount& it) {
+        return it.record == "ShortLivedRecord";
+      });
+  ASSERT_NE(it, counts.end());
+  EXPECT_EQ(it->count, 50u * 8u * 10u);
+}
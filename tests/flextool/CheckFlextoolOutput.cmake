@@ -0,0 +1,92 @@
+# Runs flextool with plugin over one input file (via RunFlextool.cmake)
+# and checks generated code and flextool log against expectations.
+#
+# usage:
+# cmake -DNAME=<test name> -DINPUT=<file.cpp> -DWORK_DIR=<dir>
+#       -DRUN_FLEXTOOL=<RunFlextool.cmake> -Dflextool=<flextool>
+#       -DPLUGIN=<plugin .so> -DINCLUDE_DIR=<dir>
+#       -DEXPECTATIONS=<name.expected.cmake> [-DEXTRA_ARGS="--extra-arg=-I..."]
+#       -P CheckFlextoolOutput.cmake
+#
+# EXPECTATIONS sets lists of substrings:
+# EXPECTED_OUTPUT and UNEXPECTED_OUTPUT are searched in generated code,
+# EXPECTED_LOG is searched in flextool log (i.e. warnings of rules).
+#
+# Writes flextool log into <WORK_DIR>/<NAME>.log
+
+cmake_minimum_required(VERSION 3.13)
+
+foreach(var NAME INPUT WORK_DIR RUN_FLEXTOOL
+            flextool PLUGIN INCLUDE_DIR EXPECTATIONS)
+  if(NOT ${var})
+    message(FATAL_ERROR "${var} is required")
+  endif()
+endforeach()
+
+include(${EXPECTATIONS})
+
+set(out_dir "${WORK_DIR}/out")
+file(REMOVE_RECURSE "${out_dir}")
+file(MAKE_DIRECTORY "${out_dir}")
+
+get_filename_component(input_dir "${INPUT}" DIRECTORY)
+
+set(ARGUMENTS
+  "--outdir=${out_dir}"
+  "--indir=${input_dir}"
+  "--load_plugin=${PLUGIN}"
+  "--extra-arg=-I${INCLUDE_DIR}")
+separate_arguments(extra_args UNIX_COMMAND "${EXTRA_ARGS}")
+list(APPEND ARGUMENTS ${extra_args})
+list(APPEND ARGUMENTS "${INPUT}")
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND}
+          "-Dflextool=${flextool}"
+          "-DARGUMENTS=${ARGUMENTS}"
+          -P ${RUN_FLEXTOOL}
+  RESULT_VARIABLE retcode
+  OUTPUT_VARIABLE log
+  ERROR_VARIABLE log)
+file(WRITE "${WORK_DIR}/${NAME}.log" "${log}")
+if(NOT "${retcode}" STREQUAL "0")
+  message(FATAL_ERROR "flextool failed on ${INPUT}: ${retcode}, "
+    "see ${WORK_DIR}/${NAME}.log")
+endif()
+
+set(output "")
+file(GLOB_RECURSE output_files "${out_dir}/*")
+foreach(output_file ${output_files})
+  file(READ "${output_file}" file_content)
+  string(APPEND output "${file_content}")
+endforeach()
+if(output STREQUAL "")
+  message(FATAL_ERROR "${NAME}: flextool produced no output in ${out_dir}")
+endif()
+
+set(failed FALSE)
+foreach(expected ${EXPECTED_OUTPUT})
+  string(FIND "${output}" "${expected}" position)
+  if(position EQUAL -1)
+    message(SEND_ERROR "${NAME}: generated code does not contain\n  ${expected}")
+    set(failed TRUE)
+  endif()
+endforeach()
+foreach(unexpected ${UNEXPECTED_OUTPUT})
+  string(FIND "${output}" "${unexpected}" position)
+  if(NOT position EQUAL -1)
+    message(SEND_ERROR "${NAME}: generated code contains\n  ${unexpected}")
+    set(failed TRUE)
+  endif()
+endforeach()
+foreach(expected ${EXPECTED_LOG})
+  string(FIND "${log}" "${expected}" position)
+  if(position EQUAL -1)
+    message(SEND_ERROR "${NAME}: flextool log does not contain\n  ${expected}")
+    set(failed TRUE)
+  endif()
+endforeach()
+if(failed)
+  message(FATAL_ERROR "${NAME}: unexpected results, generated code is in "
+    "${out_dir}, flextool log is ${WORK_DIR}/${NAME}.log")
+endif()
@@ -0,0 +1,32 @@
+# Expectations of flextool test `validate` (see CheckFlextoolOutput.cmake)
+# for validate_corpus.cpp. Items must not contain `;`.
+
+set(EXPECTED_OUTPUT
+  "(sensor >= static_cast<std::remove_cv_t<decltype(ValidateCorpus::sensor)>>(-100LL))"
+  "(sensor <= static_cast<std::remove_cv_t<decltype(ValidateCorpus::sensor)>>(1000LL))"
+  "(level <= static_cast<std::remove_cv_t<decltype(ValidateCorpus::level)>>(200ULL))"
+  "(id >= static_cast<std::remove_cv_t<decltype(ValidateCorpus::id)>>(10ULL))"
+  "(value >= static_cast<std::remove_cv_t<decltype(ValidateCorpus::value)>>(-1.5))"
+  "(value <= static_cast<std::remove_cv_t<decltype(ValidateCorpus::value)>>(1.5))"
+  "const std::remove_cv_t<decltype(ValidateCorpus::level)> value = records[i].level"
+  "static std::size_t validate_batch(const Records& records, unsigned char* valid)"
+)
+
+set(UNEXPECTED_OUTPUT
+  # checks of type limits
+  "(level >="
+  "(id <="
+  "decltype(ValidateCorpus::full)"
+  # skipped fields
+  "decltype(ValidateCorpus::overflow)"
+  "decltype(ValidateCorpus::wide)"
+  "decltype(ValidateCorpus::fractional)"
+  "decltype(ValidateCorpus::negative)"
+)
+
+set(EXPECTED_LOG
+  "make_validate skipped range(0,100000) of field ValidateCorpus::overflow"
+  "make_validate skipped range(0,300) of field ValidateCorpus::wide"
+  "make_validate skipped range(0.5,10) of field ValidateCorpus::fractional"
+  "make_validate skipped range(-1,10) of field ValidateCorpus::negative"
+)
@@ -0,0 +1,46 @@
+// input of flextool test `validate`,
+// expected results are listed in validate.expected.cmake
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace flextool_test {
+
+struct
+  __attribute__((annotate("{gen};{funccall};make_validate;")))
+ValidateCorpus {
+  __attribute__((annotate("{gen};{attr};reflectable;range(-100,1000);")))
+  int16_t sensor;
+
+  // lower bound equals limit of field type
+  __attribute__((annotate("{gen};{attr};reflectable;range(0,200);")))
+  uint8_t level;
+
+  // upper bound equals limit of field type
+  __attribute__((annotate("{gen};{attr};reflectable;range(10,4294967295);")))
+  uint32_t id;
+
+  // range covers whole field type
+  __attribute__((annotate("{gen};{attr};reflectable;range(-128,127);")))
+  int8_t full;
+
+  __attribute__((annotate("{gen};{attr};reflectable;range(-1.5,1.5);")))
+  float value;
+
+  // bounds not representable in field type are skipped
+  __attribute__((annotate("{gen};{attr};reflectable;range(0,100000);")))
+  int16_t overflow;
+
+  __attribute__((annotate("{gen};{attr};reflectable;range(0,300);")))
+  uint8_t wide;
+
+  __attribute__((annotate("{gen};{attr};reflectable;range(0.5,10);")))
+  int fractional;
+
+  __attribute__((annotate("{gen};{attr};reflectable;range(-1,10);")))
+  uint32_t negative;
+};
+
+} // namespace flextool_test
@@ -0,0 +1,212 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <flex_meta_plugin/object_pool.hpp>
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct PooledRecord {
+  PooledRecord(int id, std::string name)
+    : id(id), name(std::move(name))
+  {}
+
+  int id;
+
+  std::string name;
+};
+
+struct CountedRecord {
+  int value = 0;
+};
+
+struct ThrowingRecord {
+  explicit ThrowingRecord(bool shouldThrow)
+  {
+    if (shouldThrow) {
+      throw std::runtime_error("ThrowingRecord");
+    }
+  }
+};
+
+struct LateRecord {
+  int value = 0;
+};
+
+// destroys record on thread exit after free list of the pool
+// was released, because it is constructed before first use of the pool
+struct LateDestroyer {
+  ~LateDestroyer()
+  {
+    ::flex_meta::pool::ObjectPool<LateRecord>::instance().destroy(record);
+  }
+
+  LateRecord* record = nullptr;
+};
+
+} // namespace
+
+TEST(objectPoolTest, CreatesCacheLineAlignedObjects) {
+  using Pool = ::flex_meta::pool::ObjectPool<PooledRecord>;
+
+  std::vector<PooledRecord*> records;
+  std::set<std::uintptr_t> lines;
+  for (int i = 0; i < 3000; ++i) {
+    PooledRecord* record = Pool::instance().create(i, std::to_string(i));
+    const std::uintptr_t address
+      = reinterpret_cast<std::uintptr_t>(record);
+    EXPECT_EQ(0u, address % ::flex_meta::pool::kCacheLineSize);
+    EXPECT_TRUE(lines.insert(address).second);
+    records.push_back(record);
+  }
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ(i, records[i]->id);
+    EXPECT_EQ(std::to_string(i), records[i]->name);
+    Pool::instance().destroy(records[i]);
+  }
+
+  // freed slots are reused
+  PooledRecord* record = Pool::instance().create(1, "reused");
+  EXPECT_EQ(1u, lines.count(reinterpret_cast<std::uintptr_t>(record)));
+  Pool::instance().destroy(record);
+}
+
+TEST(objectPoolTest, ReturnsSlotIfConstructorThrows) {
+  using Pool = ::flex_meta::pool::ObjectPool<ThrowingRecord>;
+
+  ThrowingRecord* record = Pool::instance().create(false);
+  Pool::instance().destroy(record);
+  EXPECT_THROW(Pool::instance().create(true), std::runtime_error);
+  ThrowingRecord* reused = Pool::instance().create(false);
+  EXPECT_EQ(record, reused);
+  Pool::instance().destroy(reused);
+}
+
+TEST(objectPoolTest, MovesObjectsBetweenThreads) {
+  using Pool = ::flex_meta::pool::ObjectPool<PooledRecord>;
+
+  static constexpr int kThreads = 4;
+  static constexpr int kObjects = 5000;
+
+  // objects created by one thread are destroyed by another one
+  std::vector<std::vector<PooledRecord*>> created(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&created, t]() {
+      for (int i = 0; i < kObjects; ++i) {
+        created[t].push_back(Pool::instance().create(i, "thread"));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  std::set<PooledRecord*> unique;
+  for (const std::vector<PooledRecord*>& records : created) {
+    unique.insert(records.begin(), records.end());
+  }
+  EXPECT_EQ(static_cast<size_t>(kThreads * kObjects), unique.size());
+
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&created, t]() {
+      const std::vector<PooledRecord*>& records
+        = created[(t + 1) % kThreads];
+      for (int i = 0; i < kObjects; ++i) {
+        EXPECT_EQ(i, records[i]->id);
+        Pool::instance().destroy(records[i]);
+        Pool::instance().destroy(Pool::instance().create(i, "again"));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(objectPoolTest, ReusesSlotsWhenSharedStackIsLarge) {
+  using Pool = ::flex_meta::pool::ObjectPool<CountedRecord>;
+
+  static constexpr int kThreads = 4;
+  static constexpr int kRounds = 20;
+  static constexpr int kObjects = 20000;
+
+  // pushes thousands of batches into shared stack
+  {
+    std::vector<CountedRecord*> records;
+    for (int i = 0; i < 500000; ++i) {
+      records.push_back(Pool::instance().create());
+    }
+    for (CountedRecord* record : records) {
+      Pool::instance().destroy(record);
+    }
+  }
+  const size_t slabs = Pool::instance().slabCount();
+
+  // refill must not hide free batches from other threads,
+  // otherwise they allocate new slabs
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([]() {
+      std::vector<CountedRecord*> records(kObjects);
+      for (int round = 0; round < kRounds; ++round) {
+        for (CountedRecord*& record : records) {
+          record = Pool::instance().create();
+        }
+        for (CountedRecord* record : records) {
+          Pool::instance().destroy(record);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(slabs, Pool::instance().slabCount());
+}
+
+TEST(objectPoolTest, DestroysFromThreadLocalDestructors) {
+  using Pool = ::flex_meta::pool::ObjectPool<LateRecord>;
+
+  std::thread thread([]() {
+    thread_local LateDestroyer destroyer;
+    destroyer.record = Pool::instance().create();
+    destroyer.record->value = 1;
+    for (int i = 0; i < 1000; ++i) {
+      Pool::instance().destroy(Pool::instance().create());
+    }
+  });
+  thread.join();
+
+  // slots released by exited thread are reused
+  const size_t slabs = Pool::instance().slabCount();
+  std::vector<LateRecord*> records;
+  for (int i = 0; i < 100; ++i) {
+    records.push_back(Pool::instance().create());
+  }
+  for (LateRecord* record : records) {
+    Pool::instance().destroy(record);
+  }
+  EXPECT_EQ(slabs, Pool::instance().slabCount());
+}
+
+TEST(objectPoolTest, ResetsArraysAndValues) {
+  int values[2][2] = {{1, 2}, {3, 4}};
+  std::string text = "text";
+  ::flex_meta::pool::resetValue(values);
+  ::flex_meta::pool::resetValue(text);
+  EXPECT_EQ(0, values[1][1]);
+  EXPECT_TRUE(text.empty());
+}
@@ -0,0 +1,108 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <flex_meta_plugin/registry.hpp>
+
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace registry_test {
+
+// same members as generated by `make_registry`
+struct First {
+  int value;
+
+  public:
+    static constexpr ::flex_meta::registry::RecordEntry
+      flex_meta_registry_entry = {
+        "registry_test::First"
+        , 0xe14944568d95a213ULL
+        , &::flex_meta::registry::fieldsOf<First>};
+    FLEX_META_REGISTRY_SECTION
+    inline static const ::flex_meta::registry::RecordEntry*
+      flex_meta_registry_ref = &flex_meta_registry_entry;
+};
+
+// same members as generated by `make_dynamic` and `make_registry`
+struct Second {
+  int value;
+
+  public:
+    static ::flex_meta::dynamic::FieldTable dynamic_fields()
+    {
+      static constexpr ::flex_meta::dynamic::FieldEntry kFields[] = {
+        {"value"
+          , offsetof(Second, value)
+          , ::flex_meta::dynamic::fieldTypeOf<decltype(Second::value)>()
+          , &::flex_meta::dynamic::readField<
+              Second, decltype(Second::value), &Second::value>
+          , ::flex_meta::dynamic::fieldSetter<
+              Second, decltype(Second::value), &Second::value>()},
+      };
+      return ::flex_meta::dynamic::FieldTable{kFields, std::size(kFields)};
+    }
+
+  public:
+    static constexpr ::flex_meta::registry::RecordEntry
+      flex_meta_registry_entry = {
+        "registry_test::Second"
+        , ::flex_meta::registry::typeIdOf("registry_test::Second")
+        , &::flex_meta::registry::fieldsOf<Second>};
+    FLEX_META_REGISTRY_SECTION
+    inline static const ::flex_meta::registry::RecordEntry*
+      flex_meta_registry_ref = &flex_meta_registry_entry;
+};
+
+} // namespace registry_test
+
+TEST(registryTest, FindsRecordsByNameAndId) {
+  using ::flex_meta::registry::findRecord;
+  using ::flex_meta::registry::typeIdOf;
+
+  EXPECT_EQ(typeIdOf("registry_test::First")
+    , registry_test::First::flex_meta_registry_entry.typeId);
+
+  const ::flex_meta::registry::RecordEntry* first
+    = findRecord("registry_test::First");
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(&registry_test::First::flex_meta_registry_entry, first);
+  EXPECT_EQ(first, findRecord(typeIdOf("registry_test::First")));
+  EXPECT_EQ(0u, first->fields().size);
+
+  const ::flex_meta::registry::RecordEntry* second
+    = findRecord(typeIdOf("registry_test::Second"));
+  ASSERT_NE(nullptr, second);
+  EXPECT_STREQ("registry_test::Second", second->name);
+  ASSERT_EQ(1u, second->fields().size);
+  EXPECT_STREQ("value", second->fields().entries[0].name);
+
+  EXPECT_EQ(nullptr, findRecord("registry_test::Missing"));
+  EXPECT_EQ(nullptr, findRecord(typeIdOf("registry_test::Missing")));
+  EXPECT_EQ(2u, ::flex_meta::registry::Registry::instance().entries().size());
+}
+
+TEST(registryTest, SupportsConcurrentLookups) {
+  std::atomic<int> found{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&found]() {
+      for (int i = 0; i < 1000; ++i) {
+        if (::flex_meta::registry::findRecord("registry_test::Second")) {
+          found.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(8000, found.load());
+}
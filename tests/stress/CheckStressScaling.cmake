@@ -0,0 +1,71 @@
+# Compares results of full and half-sized corpus (see RunStressBudget.cmake).
+# Doubling input must not much more than double wall time or output size,
+# so quadratic behavior is caught on any machine.
+# Wall time of startup corpus is subtracted from both runs,
+# so fixed startup cost does not hide growth of short runs.
+#
+# usage:
+# cmake -DNAME=<pair name> -DFULL_RESULT=<full.stress.cmake>
+#       -DHALF_RESULT=<half.stress.cmake>
+#       -DSTARTUP_RESULT=<startup.stress.cmake>
+#       -DSCALING=<scaling.cmake> -P CheckStressScaling.cmake
+
+cmake_minimum_required(VERSION 3.13)
+
+foreach(var NAME FULL_RESULT HALF_RESULT STARTUP_RESULT SCALING)
+  if(NOT ${var})
+    message(FATAL_ERROR "${var} is required")
+  endif()
+endforeach()
+
+include(${SCALING})
+
+include(${STARTUP_RESULT})
+set(startup_wall_ms ${STRESS_RESULT_WALL_MS})
+
+include(${HALF_RESULT})
+set(half_wall_ms ${STRESS_RESULT_WALL_MS})
+set(half_output_bytes ${STRESS_RESULT_OUTPUT_BYTES})
+
+include(${FULL_RESULT})
+set(full_wall_ms ${STRESS_RESULT_WALL_MS})
+set(full_output_bytes ${STRESS_RESULT_OUTPUT_BYTES})
+
+set(failed FALSE)
+
+math(EXPR full_net_wall_ms "${full_wall_ms} - ${startup_wall_ms}")
+math(EXPR half_net_wall_ms "${half_wall_ms} - ${startup_wall_ms}")
+if(half_net_wall_ms LESS 1)
+  set(half_net_wall_ms 1)
+endif()
+
+set(min_wall_ms ${STRESS_MIN_SCALING_WALL_MS_${NAME}})
+if(NOT DEFINED min_wall_ms)
+  message(FATAL_ERROR "STRESS_MIN_SCALING_WALL_MS_${NAME} is not set in ${SCALING}")
+endif()
+
+# short runs are dominated by noise
+if(full_net_wall_ms LESS min_wall_ms)
+  message(STATUS "wall time ${full_net_wall_ms} ms (without startup)"
+    " is too short to check scaling")
+else()
+  math(EXPR wall_percent "${full_net_wall_ms} * 100 / ${half_net_wall_ms}")
+  message(STATUS "wall time growth ${wall_percent}%")
+  if(wall_percent GREATER STRESS_MAX_WALL_SCALING_PERCENT)
+    message(SEND_ERROR "wall time grows ${wall_percent}% for 2x input"
+      ", limit ${STRESS_MAX_WALL_SCALING_PERCENT}%")
+    set(failed TRUE)
+  endif()
+endif()
+
+math(EXPR output_percent "${full_output_bytes} * 100 / ${half_output_bytes}")
+message(STATUS "output size growth ${output_percent}%")
+if(output_percent GREATER STRESS_MAX_OUTPUT_SCALING_PERCENT)
+  message(SEND_ERROR "output size grows ${output_percent}% for 2x input"
+    ", limit ${STRESS_MAX_OUTPUT_SCALING_PERCENT}%")
+  set(failed TRUE)
+endif()
+
+if(failed)
+  message(FATAL_ERROR "non-linear scaling between ${HALF_RESULT} and ${FULL_RESULT}")
+endif()
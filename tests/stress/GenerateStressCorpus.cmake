@@ -0,0 +1,76 @@
+# Generates synthetic input for flextool stress tests:
+# |CLASS_COUNT| annotated records, each with |FIELD_COUNT| reflectable fields.
+#
+# usage:
+# cmake -DOUTPUT=<file.cpp> -DCLASS_COUNT=5000 -DFIELD_COUNT=8
+#       [-DRULES=make_reflect;make_columnar] -P GenerateStressCorpus.cmake
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT OUTPUT OR NOT CLASS_COUNT OR NOT FIELD_COUNT)
+  message(FATAL_ERROR "OUTPUT, CLASS_COUNT and FIELD_COUNT are required")
+endif()
+
+if(NOT RULES)
+  set(RULES
+    "make_reflect"
+    "make_columnar"
+    "make_validate"
+    "make_pool(reset = \\\"true\\\")"
+    "make_dynamic"
+    "make_registry")
+endif()
+
+set(record_annotations "")
+foreach(rule ${RULES})
+  string(APPEND record_annotations
+    "  __attribute__((annotate(\"{gen};{funccall};${rule};\")))\n")
+endforeach()
+
+set(content "// generated by GenerateStressCorpus.cmake, do not edit\n")
+string(APPEND content "// records: ${CLASS_COUNT}, fields per record: ${FIELD_COUNT}\n\n")
+string(APPEND content "#include <flex_meta_plugin/columnar.hpp>\n")
+string(APPEND content "#include <flex_meta_plugin/dynamic_access.hpp>\n")
+string(APPEND content "#include <flex_meta_plugin/object_pool.hpp>\n")
+string(APPEND content "#include <flex_meta_plugin/registry.hpp>\n\n")
+string(APPEND content "#include <cstddef>\n")
+string(APPEND content "#include <cstdint>\n")
+string(APPEND content "#include <iterator>\n")
+string(APPEND content "#include <map>\n")
+string(APPEND content "#include <string>\n")
+string(APPEND content "#include <type_traits>\n")
+string(APPEND content "#include <utility>\n\n")
+string(APPEND content "namespace stress {\n")
+file(WRITE "${OUTPUT}" "${content}")
+
+# field types cycle so every rule has work for every record
+math(EXPR last_class "${CLASS_COUNT} - 1")
+math(EXPR last_field "${FIELD_COUNT} - 1")
+foreach(class RANGE ${last_class})
+  # one record per write, appending to single huge string is slow
+  set(content "\nstruct\n${record_annotations}StressRecord${class} {\n")
+  foreach(field RANGE ${last_field})
+    math(EXPR kind "${field} % 4")
+    if(kind EQUAL 0)
+      string(APPEND content
+        "  __attribute__((annotate(\"{gen};{attr};reflectable;range(0,100);\")))\n"
+        "  int32_t field${field};\n")
+    elseif(kind EQUAL 1)
+      string(APPEND content
+        "  __attribute__((annotate(\"{gen};{attr};reflectable;dictionary;\")))\n"
+        "  std::string field${field};\n")
+    elseif(kind EQUAL 2)
+      string(APPEND content
+        "  __attribute__((annotate(\"{gen};{attr};reflectable;range(-1.5,1.5);\")))\n"
+        "  double field${field};\n")
+    else()
+      # not reflectable, must be skipped by all rules
+      string(APPEND content
+        "  uint64_t field${field};\n")
+    endif()
+  endforeach()
+  string(APPEND content "};\n")
+  file(APPEND "${OUTPUT}" "${content}")
+endforeach()
+
+file(APPEND "${OUTPUT}" "\n} // namespace stress\n")
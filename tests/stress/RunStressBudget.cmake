@@ -0,0 +1,119 @@
+# Runs flextool with plugin over stress corpus (via RunFlextool.cmake),
+# measures peak RSS, wall time and size of generated output
+# and compares them with budgets.
+#
+# usage:
+# cmake -DNAME=<corpus name> -DCORPUS=<file.cpp> -DWORK_DIR=<dir>
+#       -DMEASURE_COMMAND=<measure_command> -DRUN_FLEXTOOL=<RunFlextool.cmake>
+#       -Dflextool=<flextool> -DPLUGIN=<plugin .so> -DINCLUDE_DIR=<dir>
+#       -DBUDGETS=<budgets.cmake> [-DEXTRA_ARGS="--extra-arg=-I..."]
+#       -P RunStressBudget.cmake
+#
+# Writes measured values into <WORK_DIR>/<NAME>.stress.cmake,
+# prints STRESS_BUDGET_MISSING and passes if budgets of NAME are not recorded
+
+# file(SIZE)
+cmake_minimum_required(VERSION 3.14)
+
+foreach(var NAME CORPUS WORK_DIR MEASURE_COMMAND RUN_FLEXTOOL
+            flextool PLUGIN INCLUDE_DIR BUDGETS)
+  if(NOT ${var})
+    message(FATAL_ERROR "${var} is required")
+  endif()
+endforeach()
+
+include(${BUDGETS})
+
+set(out_dir "${WORK_DIR}/out")
+file(REMOVE_RECURSE "${out_dir}")
+file(MAKE_DIRECTORY "${out_dir}")
+
+get_filename_component(corpus_dir "${CORPUS}" DIRECTORY)
+
+set(ARGUMENTS
+  "--outdir=${out_dir}"
+  "--indir=${corpus_dir}"
+  "--load_plugin=${PLUGIN}"
+  "--extra-arg=-I${INCLUDE_DIR}")
+separate_arguments(extra_args UNIX_COMMAND "${EXTRA_ARGS}")
+list(APPEND ARGUMENTS ${extra_args})
+list(APPEND ARGUMENTS "${CORPUS}")
+
+set(report "${WORK_DIR}/${NAME}.measure.txt")
+file(REMOVE "${report}")
+
+execute_process(
+  COMMAND ${MEASURE_COMMAND} ${report}
+          ${CMAKE_COMMAND}
+          "-Dflextool=${flextool}"
+          "-DARGUMENTS=${ARGUMENTS}"
+          -P ${RUN_FLEXTOOL}
+  RESULT_VARIABLE retcode)
+if(NOT "${retcode}" STREQUAL "0")
+  message(FATAL_ERROR "flextool failed on ${NAME} corpus: ${retcode}")
+endif()
+
+file(STRINGS "${report}" report_lines)
+foreach(line ${report_lines})
+  if(line MATCHES "^peak_rss_kb=([0-9]+)$")
+    set(peak_rss_kb ${CMAKE_MATCH_1})
+  elseif(line MATCHES "^wall_ms=([0-9]+)$")
+    set(wall_ms ${CMAKE_MATCH_1})
+  endif()
+endforeach()
+if(NOT DEFINED peak_rss_kb OR NOT DEFINED wall_ms)
+  message(FATAL_ERROR "malformed report ${report}")
+endif()
+
+set(output_bytes 0)
+file(GLOB_RECURSE output_files "${out_dir}/*")
+foreach(output_file ${output_files})
+  file(SIZE "${output_file}" file_bytes)
+  math(EXPR output_bytes "${output_bytes} + ${file_bytes}")
+endforeach()
+
+message(STATUS "${NAME}: peak RSS ${peak_rss_kb} KB"
+  ", wall time ${wall_ms} ms"
+  ", output ${output_bytes} bytes")
+
+file(WRITE "${WORK_DIR}/${NAME}.stress.cmake"
+  "set(STRESS_RESULT_PEAK_RSS_KB ${peak_rss_kb})\n"
+  "set(STRESS_RESULT_WALL_MS ${wall_ms})\n"
+  "set(STRESS_RESULT_OUTPUT_BYTES ${output_bytes})\n")
+
+if(output_bytes EQUAL 0)
+  message(FATAL_ERROR "${NAME}: flextool produced no output in ${out_dir}")
+endif()
+
+# budgets are recorded from measured results, never guessed,
+# so test is reported as skipped (see SKIP_REGULAR_EXPRESSION
+# in CMakeLists.txt) until baseline is recorded
+set(missing_budgets "")
+foreach(metric PEAK_RSS_KB WALL_MS OUTPUT_BYTES)
+  if(NOT DEFINED STRESS_BUDGET_${NAME}_${metric})
+    list(APPEND missing_budgets STRESS_BUDGET_${NAME}_${metric})
+  endif()
+endforeach()
+if(missing_budgets)
+  string(REPLACE ";" ", " missing_budgets "${missing_budgets}")
+  message(STATUS "STRESS_BUDGET_MISSING: ${missing_budgets} not set in ${BUDGETS}"
+    ", measured results are in ${WORK_DIR}/${NAME}.stress.cmake."
+    " To record baseline run `ctest -L stress` on reference machine,"
+    " then build target <project>-stress_update_budgets"
+    " and commit ${BUDGETS}")
+  return()
+endif()
+
+set(failed FALSE)
+foreach(metric PEAK_RSS_KB WALL_MS OUTPUT_BYTES)
+  string(TOLOWER ${metric} measured_var)
+  set(budget_var STRESS_BUDGET_${NAME}_${metric})
+  if(${${measured_var}} GREATER ${${budget_var}})
+    message(SEND_ERROR "${NAME}: ${measured_var} ${${measured_var}}"
+      " exceeds budget ${${budget_var}}")
+    set(failed TRUE)
+  endif()
+endforeach()
+if(failed)
+  message(FATAL_ERROR "${NAME}: budgets exceeded, see ${BUDGETS}")
+endif()
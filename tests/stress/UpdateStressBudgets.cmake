@@ -0,0 +1,55 @@
+# Writes budgets.cmake from results of last stress run
+# (see RunStressBudget.cmake): each budget is measured value
+# plus HEADROOM_PERCENT (50 by default).
+#
+# usage:
+# cmake -DRESULTS_DIR=<build>/tests/stress -DBUDGETS=<budgets.cmake>
+#       -DCORPORA=<name,name> [-DHEADROOM_PERCENT=50]
+#       -P UpdateStressBudgets.cmake
+
+cmake_minimum_required(VERSION 3.13)
+
+foreach(var RESULTS_DIR BUDGETS CORPORA)
+  if(NOT ${var})
+    message(FATAL_ERROR "${var} is required")
+  endif()
+endforeach()
+
+string(REPLACE "," ";" CORPORA "${CORPORA}")
+
+if(NOT DEFINED HEADROOM_PERCENT)
+  set(HEADROOM_PERCENT 50)
+endif()
+
+string(TIMESTAMP today "%Y-%m-%d" UTC)
+cmake_host_system_information(RESULT host_cpu QUERY PROCESSOR_DESCRIPTION)
+cmake_host_system_information(RESULT host_cores QUERY NUMBER_OF_PHYSICAL_CORES)
+cmake_host_system_information(RESULT host_memory_mb QUERY TOTAL_PHYSICAL_MEMORY)
+
+set(content "# Budgets checked by stress tests (RunStressBudget.cmake).\n")
+string(APPEND content "# Generated by UpdateStressBudgets.cmake from measured results\n")
+string(APPEND content "# (measured value + ${HEADROOM_PERCENT}% headroom), do not edit by hand.\n")
+string(APPEND content "# Recorded ${today} on ${host_cpu}, ${host_cores} cores, ${host_memory_mb} MB\n")
+
+foreach(name ${CORPORA})
+  set(result "${RESULTS_DIR}/${name}/${name}.stress.cmake")
+  if(NOT EXISTS "${result}")
+    message(FATAL_ERROR "${result} not found, run stress tests first")
+  endif()
+  unset(STRESS_RESULT_PEAK_RSS_KB)
+  unset(STRESS_RESULT_WALL_MS)
+  unset(STRESS_RESULT_OUTPUT_BYTES)
+  include("${result}")
+  string(APPEND content "\n# ${name}: measured"
+    " ${STRESS_RESULT_PEAK_RSS_KB} KB"
+    ", ${STRESS_RESULT_WALL_MS} ms"
+    ", ${STRESS_RESULT_OUTPUT_BYTES} bytes\n")
+  foreach(metric PEAK_RSS_KB WALL_MS OUTPUT_BYTES)
+    math(EXPR budget
+      "${STRESS_RESULT_${metric}} * (100 + ${HEADROOM_PERCENT}) / 100")
+    string(APPEND content "set(STRESS_BUDGET_${name}_${metric} ${budget})\n")
+  endforeach()
+endforeach()
+
+file(WRITE "${BUDGETS}" "${content}")
+message(STATUS "budgets written to ${BUDGETS}")
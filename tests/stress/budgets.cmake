@@ -0,0 +1,6 @@
+# Budgets checked by stress tests (RunStressBudget.cmake).
+# Generated by UpdateStressBudgets.cmake from measured results
+# (measured value + 50% headroom), do not edit by hand.
+# Baseline is not recorded yet: run stress tests on reference machine,
+# then build target flex_meta_plugin-stress_update_budgets
+# and commit this file.
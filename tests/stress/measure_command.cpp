@@ -0,0 +1,76 @@
+// Runs command and writes its peak RSS and wall time into report file,
+// used by stress tests (see RunStressBudget.cmake).
+//
+// usage: measure_command <report file> <command> [args...]
+//
+// Peak RSS is the largest RSS of command and all processes
+// it waited for, so wrapped `cmake -P RunFlextool.cmake`
+// reports peak RSS of flextool.
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) {
+    std::fprintf(stderr
+      , "usage: %s <report file> <command> [args...]\n", argv[0]);
+    return 2;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  const pid_t pid = fork();
+  if (pid < 0) {
+    std::perror("fork");
+    return 2;
+  }
+  if (pid == 0) {
+    execvp(argv[2], &argv[2]);
+    std::perror("execvp");
+    _exit(127);
+  }
+
+  int status = 0;
+  struct rusage usage{};
+  if (wait4(pid, &status, 0, &usage) < 0) {
+    std::perror("wait4");
+    return 2;
+  }
+
+  const long long wallMs
+    = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+#if defined(__APPLE__)
+  // bytes on macOS
+  const long long peakRssKb = usage.ru_maxrss / 1024;
+#else
+  // kilobytes on Linux
+  const long long peakRssKb = usage.ru_maxrss;
+#endif
+
+  const int exitCode = WIFEXITED(status)
+    ? WEXITSTATUS(status)
+    : 128 + WTERMSIG(status);
+
+  std::FILE* report = std::fopen(argv[1], "w");
+  if (!report) {
+    std::perror("fopen");
+    return 2;
+  }
+  std::fprintf(report, "peak_rss_kb=%lld\n", peakRssKb);
+  std::fprintf(report, "wall_ms=%lld\n", wallMs);
+  std::fprintf(report, "exit_code=%d\n", exitCode);
+  if (std::fclose(report) != 0) {
+    std::perror("fclose");
+    return 2;
+  }
+
+  return exitCode;
+}
@@ -0,0 +1,13 @@
+# Limits checked by CheckStressScaling.cmake.
+# Wall time of `startup` corpus (flextool and plugin startup,
+# parsing of runtime headers) is subtracted before comparison.
+
+# full corpus is twice as large as half corpus,
+# linear behavior gives about 200%, quadratic behavior gives about 400%
+set(STRESS_MAX_WALL_SCALING_PERCENT 300)
+set(STRESS_MAX_OUTPUT_SCALING_PERCENT 250)
+
+# wall time scaling of shorter runs (after startup is subtracted)
+# is not checked, because it is dominated by noise
+set(STRESS_MIN_SCALING_WALL_MS_many_classes 1000)
+set(STRESS_MIN_SCALING_WALL_MS_wide_class 250)
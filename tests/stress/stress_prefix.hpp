@@ -0,0 +1,17 @@
+#pragma once
+
+// includes shared by every stress corpus,
+// precompiled if ${ROOT_PROJECT_NAME}_STRESS_PCH_COMPILER is set
+
+#include <flex_meta_plugin/columnar.hpp>
+#include <flex_meta_plugin/dynamic_access.hpp>
+#include <flex_meta_plugin/object_pool.hpp>
+#include <flex_meta_plugin/registry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
@@ -0,0 +1,135 @@
+#include "testsCommon.h"
+
+#if !defined(USE_GTEST_TEST)
+#warning "use USE_GTEST_TEST"
+// default
+#define USE_GTEST_TEST 1
+#endif // !defined(USE_GTEST_TEST)
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// same members as generated by `make_validate` for
+// (generated code itself is checked by flextool test,
+// see flextool/validate.expected.cmake)
+//   range(-100,1000) int16_t sensor;
+//   range(0,200) uint8_t level;     (lower bound is dropped)
+//   range(10,4294967295) uint32_t id; (upper bound is dropped)
+//   range(-1.5,1.5) float value;
+struct Reading {
+  int16_t sensor;
+
+  uint8_t level;
+
+  uint32_t id;
+
+  float value;
+
+public:
+  bool validate() const
+  {
+    bool valid = true;
+    valid &= (sensor >= static_cast<std::remove_cv_t<decltype(Reading::sensor)>>(-100LL))
+      & (sensor <= static_cast<std::remove_cv_t<decltype(Reading::sensor)>>(1000LL));
+    valid &= (level <= static_cast<std::remove_cv_t<decltype(Reading::level)>>(200ULL));
+    valid &= (id >= static_cast<std::remove_cv_t<decltype(Reading::id)>>(10ULL));
+    valid &= (value >= static_cast<std::remove_cv_t<decltype(Reading::value)>>(-1.5))
+      & (value <= static_cast<std::remove_cv_t<decltype(Reading::value)>>(1.5));
+    return valid;
+  }
+
+  // sets valid[i] to 1 if records[i] is valid, else to 0
+  // returns number of valid records
+  static std::size_t validate_batch(const Reading* records, std::size_t count, unsigned char* valid)
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      valid[i] = 1;
+    }
+    {
+      const std::remove_cv_t<decltype(Reading::sensor)> min = static_cast<std::remove_cv_t<decltype(Reading::sensor)>>(-100LL);
+      const std::remove_cv_t<decltype(Reading::sensor)> max = static_cast<std::remove_cv_t<decltype(Reading::sensor)>>(1000LL);
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::remove_cv_t<decltype(Reading::sensor)> value = records[i].sensor;
+        valid[i] &= static_cast<unsigned char>((value >= min) & (value <= max));
+      }
+    }
+    {
+      const std::remove_cv_t<decltype(Reading::level)> max = static_cast<std::remove_cv_t<decltype(Reading::level)>>(200ULL);
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::remove_cv_t<decltype(Reading::level)> value = records[i].level;
+        valid[i] &= static_cast<unsigned char>((value <= max));
+      }
+    }
+    {
+      const std::remove_cv_t<decltype(Reading::id)> min = static_cast<std::remove_cv_t<decltype(Reading::id)>>(10ULL);
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::remove_cv_t<decltype(Reading::id)> value = records[i].id;
+        valid[i] &= static_cast<unsigned char>((value >= min));
+      }
+    }
+    {
+      const std::remove_cv_t<decltype(Reading::value)> min = static_cast<std::remove_cv_t<decltype(Reading::value)>>(-1.5);
+      const std::remove_cv_t<decltype(Reading::value)> max = static_cast<std::remove_cv_t<decltype(Reading::value)>>(1.5);
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::remove_cv_t<decltype(Reading::value)> value = records[i].value;
+        valid[i] &= static_cast<unsigned char>((value >= min) & (value <= max));
+      }
+    }
+    std::size_t validCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      validCount += valid[i];
+    }
+    return validCount;
+  }
+
+  // accepts any contiguous range of records (std::vector, std::array, span)
+  template<typename Records>
+  static std::size_t validate_batch(const Records& records, unsigned char* valid)
+  {
+    return validate_batch(std::data(records), std::size(records), valid);
+  }
+};
+
+} // namespace
+
+TEST(validateTest, ChecksInclusiveBounds) {
+  EXPECT_TRUE((Reading{-100, 0, 10, -1.5f}).validate());
+  EXPECT_TRUE((Reading{1000, 200, 4294967295u, 1.5f}).validate());
+  EXPECT_FALSE((Reading{-101, 0, 10, 0.0f}).validate());
+  EXPECT_FALSE((Reading{1001, 0, 10, 0.0f}).validate());
+  EXPECT_FALSE((Reading{0, 201, 10, 0.0f}).validate());
+  EXPECT_FALSE((Reading{0, 0, 9, 0.0f}).validate());
+  EXPECT_FALSE((Reading{0, 0, 10, 1.6f}).validate());
+  // NaN is never in range
+  EXPECT_FALSE((Reading{0, 0, 10, std::nanf("")}).validate());
+}
+
+TEST(validateTest, MarksOutOfRangeRecordsInBatch) {
+  std::vector<Reading> readings;
+  for (int i = 0; i < 100; ++i) {
+    readings.push_back(Reading{static_cast<int16_t>(i * 10)
+      , static_cast<uint8_t>(i), static_cast<uint32_t>(10 + i), 0.5f});
+  }
+  // out of range: sensor, level, id and value
+  readings[3].sensor = 2000;
+  readings[50].level = 255;
+  readings[70].id = 0;
+  readings[99].value = -2.0f;
+
+  std::vector<unsigned char> valid(readings.size());
+  EXPECT_EQ(Reading::validate_batch(readings, valid.data())
+    , readings.size() - 4);
+  for (size_t i = 0; i < readings.size(); ++i) {
+    EXPECT_EQ(valid[i] == 1, readings[i].validate()) << i;
+  }
+  EXPECT_EQ(valid[3], 0);
+  EXPECT_EQ(valid[50], 0);
+  EXPECT_EQ(valid[70], 0);
+  EXPECT_EQ(valid[99], 0);
+}